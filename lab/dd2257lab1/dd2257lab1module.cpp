@@ -10,6 +10,9 @@
 
 #include <dd2257lab1/dd2257lab1module.h>
 #include <dd2257lab1/utils/csvsource.h>
+#include <dd2257lab1/utils/dataframeaggregate.h>
+#include <dd2257lab1/utils/dataframefilter.h>
+#include <dd2257lab1/utils/instrumentationsummary.h>
 #include <dd2257lab1/parallelcoordinates.h>
 #include <dd2257lab1/scatterplot.h>
 #include <dd2257lab1/generate2ddata.h>
@@ -28,6 +31,9 @@ DD2257Lab1Module::DD2257Lab1Module(InviwoApplication* app) : InviwoModule(app, "
     
     // Processors
     registerProcessor<CSVSource>();
+    registerProcessor<DataFrameAggregate>();
+    registerProcessor<DataFrameFilter>();
+    registerProcessor<InstrumentationSummary>();
     registerProcessor<ParallelCoordinates>();
     registerProcessor<ScatterPlot>();
     registerProcessor<Generate2DData>();
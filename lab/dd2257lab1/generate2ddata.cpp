@@ -9,7 +9,9 @@
  */
 
 #include <dd2257lab1/generate2ddata.h>
-#include <random>
+#include <dd2257lab1/utils/counterrng.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
 
 
 namespace inviwo
@@ -40,6 +42,13 @@ Generate2DData::Generate2DData()
 	, muOffset("muOffset", "mu offset",0,-10,10)
 	, xTrans("xTrans", "x offset", 0, -10, 10)
 	, yTrans("yTrans", "y offset", 0, -10, 10)
+	, propNumPoints("numPoints", "Number of Points", 100, 1, 500000000)
+	, propSeed("seed", "Seed", 0, 0, 1000000)
+	, propColumns("columns", "Additional Columns")
+	, propFloatColumns("floatColumns", "Float Columns", 0, 0, 64)
+	, propIntColumns("intColumns", "Integer Columns", 0, 0, 64)
+	, propCategoricalColumns("categoricalColumns", "Categorical Columns", 0, 0, 64)
+	, propCategories("categories", "Categories", 10, 1, 1000000)
 {
     //Register ports
     
@@ -54,6 +63,13 @@ Generate2DData::Generate2DData()
 	addProperty(muOffset);
 	addProperty(xTrans);
 	addProperty(yTrans);
+	addProperty(propNumPoints);
+	addProperty(propSeed);
+	propColumns.addProperty(propFloatColumns);
+	propColumns.addProperty(propIntColumns);
+	propColumns.addProperty(propCategoricalColumns);
+	propColumns.addProperty(propCategories);
+	addProperty(propColumns);
     propdataShape.addOption("line", "Line", DataShape::Line);
     propdataShape.addOption("circle", "Circle", DataShape::Circle);
     propdataShape.addOption("hyperbola", "Hyperbola", DataShape::Hyperbola);
@@ -64,132 +80,112 @@ Generate2DData::Generate2DData()
 
 void Generate2DData::process()
 {
+    DD2257_SCOPED_TIMER("Generate2DData::process");
     // Initialize the dataframe
     auto dataframe = std::make_shared<DataFrame>();
 
-    // Create data container with two columns
-    auto colX = dataframe->addColumn<float>("x");
-    auto colY = dataframe->addColumn<float>("y");
-
-    // Lamda function for adding a single data point
-    auto addPoint = [&](float x, float y)
-    {
-        colX->add(x);
-        colY->add(y);
-    };
-
-	//index for how many points that should be created
-	const int numPoints = 100;
-	//init arrays for points
-	float x[numPoints], y[numPoints];
-
-    switch (propdataShape.get())
-    {
-        case DataShape::Line: {
-
-            // TODO: Add points that lie on a line with negative slope
-			//init K as negative slope and m as intercept values may need be changed
-			const float K = -1;
-			const float m = 1;
-			//min <= max else error (as an offset is calculated in the uniform_real_distribution(..)
-			const double max = 1.0;
-			const double min = 0.0;
-			//Stuff needed for random number generation
-			std::random_device                  rand_dev; //seed for random generator
-			std::mt19937                        generator(rand_dev()); //Standard mersenne_twister_engine
-			std::uniform_real_distribution<double>  dis(min, max);
-			//create for loop to add N points of the form y = -kx + m 
-			//as we want to create points forming a line with negative slope
-
-			//create uniformly distributed points for x_j first
-			for (int j = 0; j < numPoints; j++) {
-				//dis is used to transform unsigned int to a double
-				x[j] = (float) dis(generator);
+	// number of points per shape, the hyperbola consists of two branches
+	const size_t numPoints = propNumPoints.get();
+	const size_t numRows = (propdataShape.get() == DataShape::Hyperbola) ? 2 * numPoints : numPoints;
+	const std::uint64_t seed = static_cast<std::uint64_t>(propSeed.get());
+
+	// Columns are allocated up front and filled in parallel, every value is derived from
+	// the seed, its column, and its row. Thus, the result is independent of the number of threads.
+	auto createValues = [&](auto column) -> auto & {
+		auto &values = column->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+		values.resize(numRows);
+		return values;
+	};
+	auto &x = createValues(dataframe->addColumn<float>("x"));
+	auto &y = createValues(dataframe->addColumn<float>("y"));
+
+	std::uint64_t stream = 0;
+	const util::CounterRNG shapeRng(seed, stream++);
+
+	// copy property values, they must not be accessed from other threads
+	const DataShape shape = propdataShape.get();
+	const float a = aScalar.get();
+	const float b = bScalar.get();
+	const float muScale = muScalar.get();
+	const float angle = muOffset.get();
+	const vec2 offset(xTrans.get(), yTrans.get());
+
+	util::forEachRangeParallel(numRows, [&](size_t begin, size_t end, size_t) {
+		for (size_t i = begin; i < end; i++) {
+			const float u = static_cast<float>(shapeRng.uniform(i));
+			switch (shape)
+			{
+				case DataShape::Line: {
+					// points on a line with negative slope, y = K x + m with x in [0, 1)
+					const float K = -1;
+					const float m = 1;
+					x[i] = u;
+					y[i] = u * K + m;
+					break;
+				}
+				case DataShape::Circle: {
+					// circle with origin in (0,0) and fixed radius
+					// x = r cos(theta), y = r sin(theta) with theta in [0, 2pi)
+					const float r = 5.0f;
+					const float theta = 2 * static_cast<float>(M_PI) * u;
+					x[i] = r * std::cos(theta);
+					y[i] = r * std::sin(theta);
+					break;
+				}
+				case DataShape::Hyperbola: {
+					// x = a cosh(mu), y = b sinh(mu) with mu in [-3, 3), the second half of
+					// the rows forms the branch with negative x
+					const float mu = -3.0f + 6.0f * u;
+					const float branch = (i < numPoints) ? 1.0f : -1.0f;
+					const float px = a * branch * std::cosh(muScale * mu) + offset.x;
+					const float py = b * std::sinh(muScale * mu) + offset.y;
+					// rotate by the mu offset
+					x[i] = px * std::cos(angle) - py * std::sin(angle);
+					y[i] = py * std::cos(angle) + px * std::sin(angle);
+					break;
+				}
+				default: {
+					break;
+				}
 			}
-
-			//create points for y_i
-			for (int i = 0; i < numPoints; i++) {
-				y[i] = x[i] * K + m;
-				//add N points with O(n) complexity in worst case
-				addPoint(x[i], y[i]);
-				//addPoint(0.3f, 0.4f);
+		}
+	}, 1 << 16);
+
+	// Additional random columns for load testing
+	for (size_t c = 0; c < propFloatColumns.get(); c++) {
+		auto &values = createValues(dataframe->addColumn<float>("float " + std::to_string(c + 1)));
+		const util::CounterRNG rng(seed, stream++);
+		util::forEachRangeParallel(numRows, [&](size_t begin, size_t end, size_t) {
+			for (size_t i = begin; i < end; i++) {
+				values[i] = static_cast<float>(rng.uniform(i));
 			}
-
-            break;
-        }
-        case DataShape::Circle: {
-			//random number generator
-			std::random_device                  rand_dev; //seed for random generator
-			std::mt19937                        generator(rand_dev()); //Standard mersenne_twister_engine
-			// circle with orgin in (0,0)
-			// x = r cos(theta), y = r sin(theta)
-			//define radius and theta
-			const float r = 5.0f; 
-			//loop for all points
-			for (int i = 0; i < numPoints; i++) {
-				//chose random radius in [0, r]
-				//chose random angle between [0, 2pi]
-				//float radius = r*sqrt(generator());
-				//keep radius fixed
-				float radius = r;
-				float theta = 2 * M_PI*generator();
-				//convert to x,y coordinates
-				x[i] = radius * cos(theta);
-				y[i] = radius * sin(theta);
-				// TODO: Add points that lie on a circle
-				//addPoint(0.24f, 0.4f);
-				//add points
-				addPoint(x[i], y[i]);
-
+		}, 1 << 16);
+	}
+	for (size_t c = 0; c < propIntColumns.get(); c++) {
+		auto &values = createValues(dataframe->addColumn<std::int32_t>("int " + std::to_string(c + 1)));
+		const util::CounterRNG rng(seed, stream++);
+		util::forEachRangeParallel(numRows, [&](size_t begin, size_t end, size_t) {
+			for (size_t i = begin; i < end; i++) {
+				values[i] = static_cast<std::int32_t>(rng.uniformInt(i, 1000));
 			}
-
-            break;
-        }
-        case DataShape::Hyperbola: {
-
-            // TODO: Add points that lie on a hyperbola
-			// x = a cosh(mu), y = b sinh(mu)
-			const double max = 3.0;
-			const double min = -3.0;
-			//Stuff needed for random number generation
-			//std::random_device                  rand_dev; //seed for random generator
-			//std::mt19937                        generator(rand_dev()); //Standard mersenne_twister_engine
-			std::default_random_engine generator;
-			std::uniform_real_distribution<double>  dis(min, max);
-
-			float alpha = 1.0f, beta = 1.0f;
-			for (int i = 0; i < numPoints; i++) {
-				//generate random mu in range [-3,3]
-				float mu = (float)dis(generator);
-				//calculate x,y in hyperbolic coordinates
-				x[i] = aScalar.get()*alpha*cosh(muScalar.get()*mu) +xTrans.get();
-				y[i] = bScalar.get()*beta*sinh(muScalar.get()*mu)+yTrans.get();
-				//update alpha and beta (not sure how??
-				//addPoint(0.3f, 0.4f);
-				x[i] = x[i] * cos(muOffset.get()) - y[i] * sin(muOffset.get());
-				y[i] = y[i] * cos(muOffset.get()) + x[i] * sin(muOffset.get());
-				addPoint(x[i], y[i]);
+		}, 1 << 16);
+	}
+	const auto numCategories = static_cast<std::uint32_t>(propCategories.get());
+	StringDictionary categories;
+	for (std::uint32_t k = 0; k < numCategories; k++) {
+		categories.addOrGetID("category " + std::to_string(k + 1));
+	}
+	for (size_t c = 0; c < propCategoricalColumns.get(); c++) {
+		auto column = dataframe->addCategoricalColumn("category " + std::to_string(c + 1));
+		column->setDictionary(categories);
+		auto &values = createValues(column);
+		const util::CounterRNG rng(seed, stream++);
+		util::forEachRangeParallel(numRows, [&](size_t begin, size_t end, size_t) {
+			for (size_t i = begin; i < end; i++) {
+				values[i] = rng.uniformInt(i, numCategories);
 			}
-
-			//add same points with neg direction to get other part of hyperbola
-			for (int i = 0; i < numPoints; i++) {
-				//generate random mu in range [-3,3]
-				float mu = (float)dis(generator);
-				//calculate x,y in hyperbolic coordinates
-				x[i] = aScalar.get()*alpha*-cosh(muScalar.get()*mu)+xTrans.get();
-				y[i] = bScalar.get()*beta*sinh(muScalar.get()*mu)+yTrans.get();
-				//update alpha and beta (not sure how??
-				//addPoint(0.3f, 0.4f);
-				x[i] = x[i] * cos(muOffset.get()) - y[i] * sin(muOffset.get());
-				y[i] = y[i] * cos(muOffset.get()) + x[i] * sin(muOffset.get());
-				addPoint(x[i], y[i]);
-			}
-            break;
-        }
-        default: {
-            break;
-        }
-    }
+		}, 1 << 16);
+	}
 
     // We did not take care of the indices (first column of the dataframe)
     // so we will do this now
@@ -200,4 +196,3 @@ void Generate2DData::process()
 }
 
 } // namespace
-
@@ -16,6 +16,7 @@
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/properties/compositeproperty.h>
 #include <dd2257lab1/utils/dataframe.h>
 
 
@@ -25,15 +26,25 @@ namespace inviwo
 /** \docpage{org.inviwo.Generate2DData, Generate2DData}
     ![](org.inviwo.Generate2DData.png?classIdentifier=org.inviwo.Generate2DData)
 
-    Generates datapoints of certain shape.
+    Generates datapoints of certain shape. Additional random columns can be added, e.g. for
+    load testing the plotting processors with large data. The data is generated in parallel
+    and depends only on the seed, not on the number of threads.
     
     ### Outports
       * __data__ resulting DataFrame containing three columns where the first column contains indices 
       and the second and third column contain the x and y coordinate for each data point. Thus each row
-      corresponds to one data point.
+      corresponds to one data point. Additional columns follow.
     
     ### Properties
       * __Data Shape__ shape of data that is created such as a line, circle or hyperbola.
+      * __Number of Points__ number of points per shape, the hyperbola has two branches
+        with this many points each.
+      * __Seed__ seed of the random numbers, equal seeds yield equal data.
+      * __Float Columns__ number of additional columns with uniform values in [0, 1).
+      * __Integer Columns__ number of additional columns with uniform values in [0, 1000).
+      * __Categorical Columns__ number of additional columns with uniformly distributed
+        categories.
+      * __Categories__ number of distinct categories per categorical column.
 */
 class IVW_MODULE_DD2257LAB1_API Generate2DData : public Processor
 { 
@@ -75,6 +86,14 @@ public:
 	FloatProperty muOffset;
 	FloatProperty xTrans;
 	FloatProperty yTrans;
+	IntSizeTProperty propNumPoints;
+	IntProperty propSeed;
+	// Additional random columns
+	CompositeProperty propColumns;
+	IntSizeTProperty propFloatColumns;
+	IntSizeTProperty propIntColumns;
+	IntSizeTProperty propCategoricalColumns;
+	IntSizeTProperty propCategories;
 
 //Attributes
 private:
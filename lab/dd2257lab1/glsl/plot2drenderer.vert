@@ -22,5 +22,5 @@ void main() {
     color_ = in_Color;
     texCoord_ = in_TexCoord;
 
-    gl_Position = projectionMatrix * in_Vertex;
+    gl_Position = projectionMatrix * geometry_.dataToWorld * in_Vertex;
 }
@@ -10,10 +10,15 @@
 
 #include <dd2257lab1/parallelcoordinates.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <dd2257lab1/utils/plot2drenderer.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
-#include <fstream>
 
 namespace inviwo
 {
@@ -36,8 +41,10 @@ const ProcessorInfo ParallelCoordinates::getProcessorInfo() const
 ParallelCoordinates::ParallelCoordinates()
 	:Processor()
 	, inData("indata")
+	, inSelection("selection")
 	, outMeshLines("outMeshLines")
 	, outMeshAxis("outMeshAxis")
+	, outMeshHighlight("outMeshHighlight")
 	, propColorLines("linesColor", "Line Color", vec4(0.0f, 0.0f, 1.0f, 1.0f),
 		vec4(0.0f), vec4(1.0f), vec4(0.1f),
 		InvalidationLevel::InvalidOutput, PropertySemantics::Color)
@@ -47,11 +54,32 @@ ParallelCoordinates::ParallelCoordinates()
 	, propMeshSpacing("meshSpacing", "Mesh Spacing", vec2(0.1, 0.1))
 	, propAxisHeightSpacing("axisHeightSpacing", "Axis Height Spacing", 0.1)
 	, propLinesFinder("lineFinder","Line finder", vec2(0, 0))
+	, propMode("mode", "Mode",
+		{ { "lines", "Lines", static_cast<int>(PlotMode::Lines) },
+		  { "density", "Density", static_cast<int>(PlotMode::Density) } })
+	, propDensityBins("densityBins", "Bins", 64, 1, 1024)
+	, propColorLowDensity("lowDensityColor", "Low Density Color", vec4(0.8f, 0.8f, 1.0f, 1.0f),
+		vec4(0.0f), vec4(1.0f), vec4(0.1f),
+		InvalidationLevel::InvalidOutput, PropertySemantics::Color)
+	, propBrushing("brushing", "Brushing")
+	, propColorHighlight("highlightColor", "Highlight Color", vec4(1.0f, 0.5f, 0.0f, 1.0f),
+		vec4(0.0f), vec4(1.0f), vec4(0.1f),
+		InvalidationLevel::InvalidOutput, PropertySemantics::Color)
+	, propAxisOrder("axisOrder", "Axis Order")
+	, propAutoOrder("autoOrder", "Order by Correlation", false)
+	, propCorrelation("correlation", "Correlation",
+		{ { "pearson", "Pearson", static_cast<int>(CorrelationMethod::Pearson) },
+		  { "spearman", "Spearman", static_cast<int>(CorrelationMethod::Spearman) } })
+	, propCorrelationSamples("correlationSamples", "Sampled Rows (0 for all)", 500000, 0,
+		100000000, 1000)
 {
     // Register ports
     addPort(inData);
+    addPort(inSelection);
+    inSelection.setOptional(true);
     addPort(outMeshAxis);
     addPort(outMeshLines);
+    addPort(outMeshHighlight);
 
     // Register properties
     addProperty(propColorLines);
@@ -62,6 +90,52 @@ ParallelCoordinates::ParallelCoordinates()
 
 	//delete soon
 	addProperty(propLinesFinder);
+
+	addProperty(propMode);
+	addProperty(propDensityBins);
+	addProperty(propColorLowDensity);
+	auto updateVisibility = [&]() {
+		const bool density = static_cast<PlotMode>(propMode.get()) == PlotMode::Density;
+		propDensityBins.setVisible(density);
+		propColorLowDensity.setVisible(density);
+	};
+	propMode.onChange(updateVisibility);
+	updateVisibility();
+
+	addProperty(propBrushing);
+	addProperty(propColorHighlight);
+
+	propAxisOrder.addProperty(propAutoOrder);
+	propAxisOrder.addProperty(propCorrelation);
+	propAxisOrder.addProperty(propCorrelationSamples);
+	addProperty(propAxisOrder);
+	auto updateOrderVisibility = [&]() {
+		propCorrelation.setVisible(propAutoOrder.get());
+		propCorrelationSamples.setVisible(propAutoOrder.get());
+	};
+	propAutoOrder.onChange(updateOrderVisibility);
+	updateOrderVisibility();
+
+	// the line geometry only depends on the data, colors and spacings are applied in process
+	auto invalidateLines = [&]() {
+		lines_.reset();
+		highlight_.reset();
+	};
+	inData.onChange([this, invalidateLines]() {
+		invalidateLines();
+		axisColumns_.clear();
+		updateBrushes();
+	});
+	inSelection.onChange(invalidateLines);
+	propMode.onChange(invalidateLines);
+	propDensityBins.onChange(invalidateLines);
+	auto invalidateOrder = [this, invalidateLines]() {
+		invalidateLines();
+		axisColumns_.clear();
+	};
+	propAutoOrder.onChange(invalidateOrder);
+	propCorrelation.onChange(invalidateOrder);
+	propCorrelationSamples.onChange(invalidateOrder);
 }
 
 //not used for now
@@ -80,14 +154,10 @@ typedef std::shared_ptr<vec2> vec2_ptr;
 
 void ParallelCoordinates::process()
 {
-
-	//file to see what's going on
-	std::ofstream myfile;
-	myfile.open("wubalubadubdub.txt");
+	DD2257_SCOPED_TIMER("ParallelCoordinates::process");
 
 	auto dataFrame = inData.getData();
 
-	auto meshPoints = std::make_shared<BasicMesh>();
 	auto meshAxes = std::make_shared<BasicMesh>();
 
 	size_t numberOfRows = dataFrame->getNumberOfRows();
@@ -106,84 +176,84 @@ void ParallelCoordinates::process()
 	// are given in the Scatter plot processor
 
 
+	// data stage, the axis order and the geometry in normalized plot coordinates
+	if (axisColumns_.empty()) {
+		axisColumns_ = computeAxisOrder(*dataFrame);
+	}
+
 	// find min/max values per column
 	std::vector<double> colMinV;
 	std::vector<double> colMaxV;
 
-	//start at 1 for skipping index column in dataframe
-	for (int i = 1; i < numberOfColumns; i++) {
-		double colMin = std::numeric_limits<double>::max(), colMax = std::numeric_limits<double>::min();
+	for (auto i : axisColumns_) {
+		// value ranges are cached by the columns, no need to scan them again
 		auto column = dataFrame->getColumn(i);
-		for (int j = 0; j < numberOfRows; j++) {
-			colMin = column->getAsDouble(j) < colMin ? column->getAsDouble(j) : colMin;
-			colMax = column->getAsDouble(j) > colMax ? column->getAsDouble(j) : colMax;
-		}
+		auto stats = column->getStatistics();
+		double colMin = stats->min, colMax = stats->max;
 		//adding the min/max of all min and max values
 		colMinV.push_back(colMin);
 		colMaxV.push_back(colMax);
-		
-		myfile << "The column " << column ->  getHeader() << " ( col: " << i << " ) has the min: "<< colMin << " and max: "<< colMax << std::endl;
-		myfile << "The column accessed by index  has the min: " << colMinV[i-1] << " and max: " << colMaxV[i-1] << std::endl;
 	}
-	myfile << std::endl;
+
+	// rows to draw, either all or the ones of the selection. The indices are read directly
+	// from the index buffer of the selection
+	const std::vector<std::uint32_t>* selectedRows = nullptr;
+	std::shared_ptr<const Selection> selection;
+	if (inSelection.hasData()) {
+		selection = inSelection.getData();
+		if (selection->getSize() != numberOfRows) {
+			throw Exception("Selection does not match the number of rows of the data");
+		}
+		selectedRows = &selection->getIndexBuffer()->getRAMRepresentation()->getDataContainer();
+	}
 
 	std::vector<BasicMesh::Vertex> verticesAxis;
-	std::vector<BasicMesh::Vertex> verticesPoints;
 
 	auto indexBufferLinesAxis =
 		meshAxes->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
 
-	auto indexBufferLinesPoints =
-		meshPoints->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
-
 	int axisIndex = 0;
-	int pointIndex = 0;
+	const size_t axisCount = numberOfColumns - 1 /*one more for header*/;
 	//distance between two columns (dx) on plot
 	//height of axis in the plot (dH) - the white line.
-	float dx = (1 - 2 * propMeshSpacing.get()[0]) / (numberOfColumns- 1 - 1 /*one more for header*/);
+	float dx = axisCount > 1 ? (1 - 2 * propMeshSpacing.get()[0]) / (axisCount - 1) : 0.0f;
 	float gH = (1 - 2 * propMeshSpacing.get()[1]);
 	vec3 axisDelta( dx, 0, 0);
 	vec3 axisHeight( 0, gH, 0);
 	//property in order to shift blue lines for testing
 	vec3 linesFinder(propLinesFinder.get(), 0);
 
-
-	
-
-    for (int i = 0; i < numberOfColumns-1 -1 /*one more for header*/; i++) {
-		// TODO check if it's nominal or chategorical variable
-		
-		//add points lines same ideas as with scatterplot
-		for (int j = 0; j < dataFrame->getColumn(i+1/*one more for header*/)->getSize(); j++) {
-			float x = (float)dataFrame->getColumn(i+1/*one more for header*/)->getAsDouble(j);
-			float y = (float)dataFrame->getColumn(i + 1 +1/*one more for header*/)->getAsDouble(j);
-			float px = (x - colMinV[i]) / (colMaxV[i] - colMinV[i]) ;
-			float py = (y - colMinV[i+1]) / (colMaxV[i+1] - colMinV[i+1]);
-
-			//logging
-			myfile << "In dataframe: row = "<< i << " col = "<< j << std::endl;
-			myfile << "Dataset point: x = " << x << " y = " << y << std::endl;
-			myfile << "x-min = " << (x - colMinV[i]) << " y - min = " << (y - colMinV[i + 1]) << std::endl;
-			myfile << " Xmin= " << colMinV[i] << " Xmax= " << colMaxV[i] << std::endl;
-			myfile << " Ymin= " << colMinV[i+1] << " Ymax= " << colMaxV[i+1] << std::endl;
-			myfile << " X(Max-min) = " << (colMaxV[i] - colMinV[i]) << " Y(Max-min)  = " << (colMaxV[i + 1] - colMinV[i + 1] )<< std::endl;
-			myfile << "Scaled point: x = " << px << " y = " << py << std::endl;
-
-			// x
-			verticesPoints.push_back({ linesFinder + diagramOrigin + axisDelta * (float)i + axisHeight * px, vec3(0), vec3(0), propColorLines.get()});
-			indexBufferLinesPoints->add(static_cast<std::uint32_t>(pointIndex));
-			pointIndex++;
-
-			// y
-			verticesPoints.push_back({ linesFinder + diagramOrigin + axisDelta * (float)(i+1) + axisHeight *py, vec3(0), vec3(0), propColorLines.get() });
-			indexBufferLinesPoints->add(static_cast<std::uint32_t>(pointIndex));
-			pointIndex++;
-
-			myfile << "Point on grid: x = " << linesFinder + diagramOrigin + axisDelta * (float)i + axisHeight * px << " y = " << linesFinder + diagramOrigin + axisDelta * (float)(i + 1) + axisHeight *py << std::endl;
-			myfile << std::endl;
+	const bool density = static_cast<PlotMode>(propMode.get()) == PlotMode::Density;
+	if (!lines_) {
+		AxisLayout layout;
+		layout.columns = axisColumns_;
+		layout.min = colMinV;
+		layout.max = colMaxV;
+		if (density) {
+			lines_ = createDensityMesh(*dataFrame, selectedRows, layout);
+		} else {
+			lines_ = createLineMesh(*dataFrame, selectedRows, layout);
+			highlight_ = util::make_unique<PlotMesh>(lines_->getPositions());
+			highlightBrushes_.clear();
 		}
+	}
+	if (highlight_) {
+		updateHighlight(*dataFrame, selectedRows);
+	}
 
+	// presentation stage, neither of them touches the vertex positions
+	lines_->setColors(propColorLines.get(), propColorLowDensity.get());
+	const vec2 lineOrigin(linesFinder.x + diagramOrigin.x, linesFinder.y + diagramOrigin.y);
+	const vec2 lineSize(1 - 2 * propMeshSpacing.get()[0], gH);
+	auto meshLines = lines_->getMesh(lineOrigin, lineSize);
+	std::shared_ptr<Mesh> meshHighlight = std::make_shared<Mesh>();
+	if (highlight_ && highlight_->hasIndices()) {
+		highlight_->setColors(propColorHighlight.get());
+		// in front of the lines, which are drawn with depth test at depth zero
+		meshHighlight = highlight_->getMesh(lineOrigin, lineSize, 1.0f);
+	}
 
+	for (size_t i = 0; i + 1 < axisCount; i++) {
 		// add axis lines 
 		verticesAxis.push_back({ diagramOrigin + axisDelta * (float)i, vec3(0), vec3(0), propColorAxes.get() });
 		indexBufferLinesAxis->add(static_cast<std::uint32_t>(axisIndex));
@@ -195,22 +265,273 @@ void ParallelCoordinates::process()
 
 	}
 	// add the last line
-	verticesAxis.push_back({ diagramOrigin + axisDelta * (float)(numberOfColumns-1 - 1 /*one more for header*/), vec3(0), vec3(0), propColorAxes.get() });
+	verticesAxis.push_back({ diagramOrigin + axisDelta * (float)(axisCount - 1), vec3(0), vec3(0), propColorAxes.get() });
 	indexBufferLinesAxis->add(static_cast<std::uint32_t>(axisIndex));
 	axisIndex++;
 
-	verticesAxis.push_back({ diagramOrigin + axisDelta * (float)(numberOfColumns - 1 - 1 /*one more for header*/) + axisHeight, vec3(0), vec3(0), propColorAxes.get() });
+	verticesAxis.push_back({ diagramOrigin + axisDelta * (float)(axisCount - 1) + axisHeight, vec3(0), vec3(0), propColorAxes.get() });
 	indexBufferLinesAxis->add(static_cast<std::uint32_t>(axisIndex));
 	axisIndex++;
 
 
 	meshAxes->addVertices(verticesAxis);
-	meshPoints->addVertices(verticesPoints);
+
+	DD2257_COUNTER("ParallelCoordinates::rows", selectedRows ? selectedRows->size() : numberOfRows);
+	DD2257_COUNTER("ParallelCoordinates::vertices", lines_->getNumberOfVertices());
+	DD2257_GAUGE("ParallelCoordinates::meshBytes", lines_->getSizeInBytes());
 
     // Push the mesh out
-    outMeshLines.setData(meshPoints);
+    outMeshLines.setData(meshLines);
     outMeshAxis.setData(meshAxes);
-	myfile.close();
+    outMeshHighlight.setData(meshHighlight);
+}
+
+std::unique_ptr<PlotMesh> ParallelCoordinates::createLineMesh(const DataFrame& dataFrame,
+	const std::vector<std::uint32_t>* selectedRows, const AxisLayout& layout) const
+{
+	const size_t axisCount = layout.getAxisCount();
+	const size_t rowCount = selectedRows ? selectedRows->size() : dataFrame.getNumberOfRows();
+
+	// fetch all columns in one go instead of value by value
+	std::vector<std::vector<float>> colValues;
+	for (size_t i = 0; i < axisCount; i++) {
+		auto column = dataFrame.getColumn(layout.columns[i]);
+		colValues.emplace_back(column->getSize());
+		column->getValuesAsFloat(0, column->getSize(), colValues.back().data());
+	}
+
+	// One polyline per row with one vertex per axis, so interior vertices are shared by the
+	// two adjacent segments. All polylines form a single line strip in which the rows are
+	// separated by the primitive restart index of Plot2DRenderer. The vertices only carry a
+	// position and a color, which is less than half the size of a BasicMesh vertex.
+	const size_t stripLength = axisCount + 1;
+	auto positionBuffer = std::make_shared<Buffer<vec2>>(rowCount * axisCount);
+	auto indexBufferLines =
+		std::make_shared<IndexBuffer>(rowCount > 0 ? rowCount * stripLength - 1 : 0);
+	auto& positions = positionBuffer->getEditableRAMRepresentation()->getDataContainer();
+	auto& indices = indexBufferLines->getEditableRAMRepresentation()->getDataContainer();
+
+	util::forEachRangeParallel(rowCount, [&](size_t begin, size_t end, size_t) {
+		for (size_t k = begin; k < end; k++) {
+			const size_t j = selectedRows ? (*selectedRows)[k] : k;
+			const size_t firstVertex = k * axisCount;
+			const size_t firstIndex = k * stripLength;
+			for (size_t i = 0; i < axisCount; i++) {
+				// TODO check if it's nominal or chategorical variable
+				positions[firstVertex + i] = layout.getPosition(i, colValues[i][j]);
+				indices[firstIndex + i] = static_cast<std::uint32_t>(firstVertex + i);
+			}
+			if (k + 1 < rowCount) {
+				indices[firstIndex + axisCount] = plotPrimitiveRestartIndex;
+			}
+		}
+	}, size_t{1} << 12);
+
+	auto lines = util::make_unique<PlotMesh>(positionBuffer);
+	lines->addIndices(Mesh::MeshInfo(DrawType::Lines, ConnectivityType::Strip), indexBufferLines);
+	return lines;
+}
+
+std::unique_ptr<PlotMesh> ParallelCoordinates::createDensityMesh(const DataFrame& dataFrame,
+	const std::vector<std::uint32_t>* selectedRows, const AxisLayout& layout) const
+{
+	const size_t axisCount = layout.getAxisCount();
+	const size_t bins = static_cast<size_t>(propDensityBins.get());
+
+	// One 2D histogram per pair of adjacent axes, binning the value on the left axis against
+	// the one on the right axis. The histograms are built in parallel over the rows, see
+	// computeDensityGrid, everything after that only depends on the number of bins.
+	std::vector<DensityGrid> grids;
+	double maxMagnitude = 0.0;
+	for (size_t i = 0; i + 1 < axisCount; i++) {
+		grids.push_back(computeDensityGrid(*dataFrame.getColumn(layout.columns[i]),
+			*dataFrame.getColumn(layout.columns[i + 1]), nullptr, dvec2(layout.min[i], layout.max[i]), dvec2(layout.min[i + 1], layout.max[i + 1]),
+			size2_t(bins), selectedRows));
+		maxMagnitude = std::max(maxMagnitude, grids.back().maxMagnitude);
+	}
+
+	// Every non-empty bin pair becomes a band, i.e. a quad, from the bin on the left axis to
+	// the bin on the right axis. The bands are colored on a log scale shared by all axis pairs.
+	std::vector<vec2> positions;
+	std::vector<float> colorScale;
+	auto indexBuffer = std::make_shared<IndexBuffer>();
+	auto& indices = indexBuffer->getEditableRAMRepresentation()->getDataContainer();
+	const float spacing = layout.getSpacing();
+	const float binHeight = 1.0f / static_cast<float>(bins);
+	for (size_t i = 0; i < grids.size(); i++) {
+		const auto& grid = grids[i];
+		const float left = spacing * i;
+		const float right = left + spacing;
+		for (size_t b = 0; b < bins; b++) {
+			for (size_t a = 0; a < bins; a++) {
+				const double count = grid.get(a, b);
+				if (count == 0.0) continue;
+
+				const float t = maxMagnitude > 0.0
+					? static_cast<float>(std::log1p(count) / std::log1p(maxMagnitude)) : 0.0f;
+				const float bottomLeft = binHeight * a;
+				const float bottomRight = binHeight * b;
+				const auto first = static_cast<std::uint32_t>(positions.size());
+				positions.push_back(vec2(left, bottomLeft));
+				positions.push_back(vec2(right, bottomRight));
+				positions.push_back(vec2(right, bottomRight + binHeight));
+				positions.push_back(vec2(left, bottomLeft + binHeight));
+				colorScale.insert(colorScale.end(), 4, t);
+				for (auto v : { 0u, 1u, 2u, 0u, 2u, 3u }) {
+					indices.push_back(first + v);
+				}
+			}
+		}
+	}
+
+	auto mesh = util::make_unique<PlotMesh>(std::move(positions), std::move(colorScale));
+	mesh->addIndices(Mesh::MeshInfo(DrawType::Triangles, ConnectivityType::None), indexBuffer);
+	return mesh;
+}
+
+std::vector<size_t> ParallelCoordinates::computeAxisOrder(const DataFrame& dataFrame) const
+{
+	//start at 1 for skipping index column in dataframe
+	std::vector<size_t> columns;
+	for (size_t i = 1; i < dataFrame.getNumberOfColumns(); i++) {
+		columns.push_back(i);
+	}
+	if (!propAutoOrder.get()) return columns;
+
+	// categorical values are category IDs, a correlation of them is meaningless
+	std::vector<size_t> numeric;
+	std::vector<size_t> categorical;
+	std::vector<const Column*> numericColumns;
+	for (auto i : columns) {
+		auto column = dataFrame.getColumn(i);
+		if (dynamic_cast<const CategoricalColumn*>(column.get())) {
+			categorical.push_back(i);
+		} else {
+			numeric.push_back(i);
+			numericColumns.push_back(column.get());
+		}
+	}
+
+	const auto matrix = computeCorrelationMatrix(numericColumns,
+		static_cast<CorrelationMethod>(propCorrelation.get()), propCorrelationSamples.get());
+	columns.clear();
+	for (auto k : findCorrelationOrder(matrix)) {
+		columns.push_back(numeric[k]);
+	}
+	columns.insert(columns.end(), categorical.begin(), categorical.end());
+	return columns;
+}
+
+void ParallelCoordinates::updateBrushes()
+{
+	sortedIndices_.clear();
+	for (auto property : propBrushing.getProperties()) {
+		property->setVisible(false);
+	}
+	if (!inData.hasData()) return;
+
+	auto dataFrame = inData.getData();
+	sortedIndices_.resize(dataFrame->getNumberOfColumns());
+	//start at 1 for skipping index column in dataframe
+	for (size_t i = 1; i < dataFrame->getNumberOfColumns(); i++) {
+		const std::string identifier = "brush" + std::to_string(i);
+		auto brush = dynamic_cast<DoubleMinMaxProperty*>(propBrushing.getPropertyByIdentifier(identifier));
+		if (!brush) {
+			brush = new DoubleMinMaxProperty(identifier, identifier, 0.0, 1.0, 0.0, 1.0);
+			propBrushing.addProperty(brush, true);
+		}
+		auto column = dataFrame->getColumn(i);
+		brush->setDisplayName(column->getHeader());
+		brush->setVisible(true);
+
+		auto stats = column->getStatistics();
+		if (stats->size == stats->nanCount) continue;
+		// keep the brush as long as the value range of the axis stays the same
+		const dvec2 bounds(stats->min, stats->max);
+		if (brush->getRange() != bounds) {
+			brush->setRange(bounds);
+			brush->set(bounds);
+		}
+	}
+}
+
+void ParallelCoordinates::updateHighlight(const DataFrame& dataFrame,
+	const std::vector<std::uint32_t>* selectedRows)
+{
+	std::vector<std::pair<size_t, dvec2>> brushes;
+	for (size_t i = 1; i < dataFrame.getNumberOfColumns() && i < sortedIndices_.size(); i++) {
+		auto brush = dynamic_cast<const DoubleMinMaxProperty*>(
+			propBrushing.getPropertyByIdentifier("brush" + std::to_string(i)));
+		if (!brush) continue;
+		const dvec2 range = brush->get();
+		if (range.x <= brush->getRangeMin() && range.y >= brush->getRangeMax()) continue;
+		brushes.emplace_back(i, range);
+	}
+	// process is also called for style changes, which must not resolve the brushes again
+	if (brushes == highlightBrushes_) return;
+
+	DD2257_SCOPED_TIMER("ParallelCoordinates::brush");
+	highlightBrushes_ = brushes;
+	highlight_->clearIndices();
+	if (brushes.empty()) return;
+
+	std::vector<const SortedColumnIndex*> indices;
+	std::vector<dvec2> ranges;
+	for (const auto& brush : brushes) {
+		auto& index = sortedIndices_[brush.first];
+		if (!index) {
+			index = util::make_unique<SortedColumnIndex>(*dataFrame.getColumn(brush.first));
+		}
+		indices.push_back(index.get());
+		ranges.push_back(brush.second);
+	}
+
+	// brushed rows are ascending, the strips follow the ascending rows of the selection
+	const auto brushedRows = findRowsInRanges(indices, ranges);
+	std::vector<std::uint32_t> strips;
+	if (selectedRows) {
+		auto brushed = brushedRows.begin();
+		for (size_t k = 0; k < selectedRows->size() && brushed != brushedRows.end(); k++) {
+			brushed = std::lower_bound(brushed, brushedRows.end(), (*selectedRows)[k]);
+			if (brushed != brushedRows.end() && *brushed == (*selectedRows)[k]) {
+				strips.push_back(static_cast<std::uint32_t>(k));
+			}
+		}
+	} else {
+		strips = brushedRows;
+	}
+	DD2257_COUNTER("ParallelCoordinates::brushedRows", strips.size());
+	if (strips.empty()) return;
+
+	const size_t axisCount = dataFrame.getNumberOfColumns() - 1;
+	const size_t stripLength = axisCount + 1;
+	auto indexBuffer = std::make_shared<IndexBuffer>(strips.size() * stripLength - 1);
+	auto& stripIndices = indexBuffer->getEditableRAMRepresentation()->getDataContainer();
+	util::forEachRangeParallel(strips.size(), [&](size_t begin, size_t end, size_t) {
+		for (size_t k = begin; k < end; k++) {
+			const size_t firstVertex = strips[k] * axisCount;
+			for (size_t i = 0; i < axisCount; i++) {
+				stripIndices[k * stripLength + i] = static_cast<std::uint32_t>(firstVertex + i);
+			}
+			if (k + 1 < strips.size()) {
+				stripIndices[k * stripLength + axisCount] = plotPrimitiveRestartIndex;
+			}
+		}
+	}, size_t{1} << 12);
+
+	highlight_->addIndices(Mesh::MeshInfo(DrawType::Lines, ConnectivityType::Strip), indexBuffer);
+}
+
+float ParallelCoordinates::AxisLayout::getSpacing() const
+{
+	return getAxisCount() > 1 ? 1.0f / static_cast<float>(getAxisCount() - 1) : 0.0f;
+}
+
+vec2 ParallelCoordinates::AxisLayout::getPosition(size_t axis, double value) const
+{
+	const double range = max[axis] - min[axis];
+	const float p = range > 0.0 ? static_cast<float>((value - min[axis]) / range) : 0.5f;
+	return vec2(getSpacing() * axis, p);
 }
 
 } // namespace
@@ -14,7 +14,18 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
 #include <dd2257lab1/utils/dataframe.h>
+#include <dd2257lab1/utils/selection.h>
 #include <inviwo/core/ports/meshport.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/minmaxproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <dd2257lab1/utils/correlation.h>
+#include <dd2257lab1/utils/densitygrid.h>
+#include <dd2257lab1/utils/plotmesh.h>
+#include <dd2257lab1/utils/sortedindex.h>
 
 namespace inviwo
 {
@@ -28,20 +39,46 @@ namespace inviwo
     * __data__ DataFrame containing a number columns where the first column contains indices
     and subsequent columns contain values for each dimension. Thus each row corresponds to
     one data point.
+    * __selection__ Optional selection of rows, only the selected rows are drawn.
 
     ### Outports
-    * __Line Mesh__ Mesh resembling the line segment in the scatter plot.
+    * __Line Mesh__ Mesh resembling the line segment in the scatter plot. Each row is one
+    line strip with a vertex per axis, the strips are separated by plotPrimitiveRestartIndex
+    and thus have to be drawn with the 2D Plot Renderer. In density mode the mesh instead
+    contains one triangle band per non-empty bin pair of adjacent axes.
     * __Axis Mesh__ Mesh resembling the axes in the scatter plot.
+    * __Highlight Mesh__ Line strips of the rows within all brushes. The mesh shares the vertex
+    positions of the Line Mesh and only has its own index buffer, thus brushing never rebuilds
+    the lines. Empty in density mode or if no brush is active. Connect it to the same 2D Plot
+    Renderer as the Line Mesh, it is drawn in front of the lines, as in the shipped workspaces.
 
     ### Properties
     * __Point Color__ Color for points.
     * __Axes Color__ Color for axes.
+    * __Mode__ Lines draws one polyline per row. Density bins the values of each pair of
+    adjacent axes into a 2D histogram and draws one band per non-empty bin pair, so the mesh
+    size depends on the number of bins instead of the number of rows.
+    * __Bins__ Number of bins per axis in density mode.
+    * __Low Density Color__ Color of the sparsest bands, the densest use the line color.
+    * __Brushing__ One value range per axis, a brush is active unless it covers the whole
+    axis. Each brushed axis is sorted once per data change, brushes are then resolved by
+    binary search and intersected, see findRowsInRanges.
+    * __Highlight Color__ Color of the brushed lines.
+    * __Axis Order__ By default the axes follow the column order. Otherwise the numeric columns
+    are ordered such that adjacent axes are strongly correlated, see computeCorrelationMatrix
+    and findCorrelationOrder. Categorical columns follow in their original order. For large
+    tables the correlation is estimated from a sample of the rows.
+
+    The line geometry is built in normalized plot coordinates and only rebuilt when the data,
+    the selection, the mode or the bins change. Colors and spacings are applied to the cached
+    geometry, see PlotMesh.
 */
 class IVW_MODULE_DD2257LAB1_API ParallelCoordinates : public Processor
 { 
 //Friends
 //Types
 public:
+    enum class PlotMode { Lines, Density };
 
 //Construction / Deconstruction
 public:
@@ -57,11 +94,44 @@ protected:
     ///Our main computation function
     virtual void process() override;
 
+    /// Value ranges of the axes, which span [0, 1]^2 in normalized plot coordinates
+    struct AxisLayout {
+        std::vector<size_t> columns; ///< column of the data frame shown on each axis
+        std::vector<double> min; ///< value at the bottom of each axis
+        std::vector<double> max; ///< value at the top of each axis
+
+        size_t getAxisCount() const { return min.size(); }
+        /// Distance between adjacent axes
+        float getSpacing() const;
+        /// Position of \p value on the given axis
+        vec2 getPosition(size_t axis, double value) const;
+    };
+
+    /// One polyline per row, see Line Mesh
+    std::unique_ptr<PlotMesh> createLineMesh(const DataFrame& dataFrame,
+        const std::vector<std::uint32_t>* selectedRows, const AxisLayout& layout) const;
+
+    /// One band per non-empty bin pair of adjacent axes, see Mode
+    std::unique_ptr<PlotMesh> createDensityMesh(const DataFrame& dataFrame,
+        const std::vector<std::uint32_t>* selectedRows, const AxisLayout& layout) const;
+
+    /// Columns of the data frame in the order of the axes, see Axis Order
+    std::vector<size_t> computeAxisOrder(const DataFrame& dataFrame) const;
+
+    /// Adds a brush for each column of the data and drops the sorted indices
+    void updateBrushes();
+
+    /// Sets the line strips of the brushed rows as indices of highlight_ if the brushes changed
+    void updateHighlight(const DataFrame& dataFrame,
+        const std::vector<std::uint32_t>* selectedRows);
+
 //Ports
 public:
     DataInport<DataFrame> inData;
+    SelectionInport inSelection;
     MeshOutport outMeshAxis;
     MeshOutport outMeshLines;
+    MeshOutport outMeshHighlight;
 
 //Properties
 public:
@@ -75,8 +145,33 @@ public:
 	FloatProperty propAxisHeightSpacing;
 	FloatVec2Property propLinesFinder;
 
+	//aggregation
+	OptionPropertyInt propMode;
+	IntProperty propDensityBins;
+	FloatVec4Property propColorLowDensity;
+
+	//brushing
+	CompositeProperty propBrushing;
+	FloatVec4Property propColorHighlight;
+
+	//axis order
+	CompositeProperty propAxisOrder;
+	BoolProperty propAutoOrder;
+	OptionPropertyInt propCorrelation;
+	IntSizeTProperty propCorrelationSamples;
+
 //Attributes
 private:
+	/// Line geometry, only rebuilt if the data changes but not for styling or brushing
+	std::unique_ptr<PlotMesh> lines_;
+	/// Columns shown on the axes, only recomputed if the data or the order settings change
+	std::vector<size_t> axisColumns_;
+	/// Brushed lines, sharing the vertex positions of lines_
+	std::unique_ptr<PlotMesh> highlight_;
+	/// Column and range of the active brushes the indices of highlight_ were computed for
+	std::vector<std::pair<size_t, dvec2>> highlightBrushes_;
+	/// Sorted values per column of the data, built on first use of a brush
+	std::vector<std::unique_ptr<SortedColumnIndex>> sortedIndices_;
 
 };
 
@@ -10,6 +10,13 @@
 
 #include <dd2257lab1/scatterplot.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 namespace inviwo
 {
@@ -32,6 +39,7 @@ const ProcessorInfo ScatterPlot::getProcessorInfo() const
 ScatterPlot::ScatterPlot()
     :Processor()
     , inData("indata")
+    , inSelection("selection")
     , outMeshPoints("outMeshPoints")
     , outMeshLines("outMeshLines")
     , propColorPoint("pointColor", "Point Color", vec4(0.0f, 0.0f, 1.0f, 1.0f), 
@@ -43,10 +51,27 @@ ScatterPlot::ScatterPlot()
     , propXAxis("xAxis", "X Axis")
     , propYAxis("yAXis", "Y Axis")
 	, propMeshSpacing("meshSpacing", "Mesh Spacing", vec2(0.1, 0.1))
+    , propMode("mode", "Mode",
+        { { "points", "Points", static_cast<int>(PlotMode::Points) },
+          { "density", "Density", static_cast<int>(PlotMode::Density) } })
+    , propDensityBins("densityBins", "Bins", ivec2(128), ivec2(1), ivec2(2048))
+    , propDensityValue("densityValue", "Bin Value")
+    , propColorLowDensity("lowDensityColor", "Low Density Color", vec4(0.8f, 0.8f, 1.0f, 1.0f),
+        vec4(0.0f), vec4(1.0f), vec4(0.1f),
+        InvalidationLevel::InvalidOutput, PropertySemantics::Color)
+    , propLod("lod", "Level of Detail")
+    , propLodEnabled("enableLod", "Enable", false)
+    , propVertexBudget("vertexBudget", "Vertex Budget", 200000, 1000, 10000000, 1000)
+    , propViewLeft("left", "Left", 0, -5, 5)
+    , propViewRight("right", "Right", 1, -5, 5)
+    , propViewBottom("bottom", "Bottom", 0, -5, 5)
+    , propViewTop("top", "Top", 1, -5, 5)
 {
 
     // Register ports
     addPort(inData);
+    addPort(inSelection);
+    inSelection.setOptional(true);
     addPort(outMeshPoints);
     addPort(outMeshLines);
 
@@ -56,6 +81,44 @@ ScatterPlot::ScatterPlot()
     addProperty(propXAxis);
     addProperty(propYAxis);
 	addProperty(propMeshSpacing);
+    addProperty(propMode);
+    addProperty(propDensityBins);
+    addProperty(propDensityValue);
+    addProperty(propColorLowDensity);
+    propDensityValue.addOption("count", "Count", -1);
+
+    auto updateVisibility = [&]() {
+        const bool density = static_cast<PlotMode>(propMode.get()) == PlotMode::Density;
+        propDensityBins.setVisible(density);
+        propDensityValue.setVisible(density);
+        propColorLowDensity.setVisible(density);
+    };
+    propMode.onChange(updateVisibility);
+    updateVisibility();
+
+    propLod.addProperty(propLodEnabled);
+    propLod.addProperty(propVertexBudget);
+    propLod.addProperty(propViewLeft);
+    propLod.addProperty(propViewRight);
+    propLod.addProperty(propViewBottom);
+    propLod.addProperty(propViewTop);
+    addProperty(propLod);
+
+    auto resetQuadtree = [&]() { quadtree_.reset(); };
+    inData.onChange(resetQuadtree);
+    inSelection.onChange(resetQuadtree);
+    propXAxis.onChange(resetQuadtree);
+    propYAxis.onChange(resetQuadtree);
+
+    // Colors and the mesh spacing are applied to the cached points in process
+    auto resetPoints = [&]() { points_.reset(); };
+    inData.onChange(resetPoints);
+    inSelection.onChange(resetPoints);
+    propXAxis.onChange(resetPoints);
+    propYAxis.onChange(resetPoints);
+    propMode.onChange(resetPoints);
+    propDensityBins.onChange(resetPoints);
+    propDensityValue.onChange(resetPoints);
 
     // When the data changes we need new axis labels 
     inData.onChange([&]() { updateAxisLabels(); });
@@ -69,6 +132,7 @@ void ScatterPlot::updateAxisLabels()
     // Default values
     int selectedX = 0;
     int selectedY = 1;
+    const int selectedValue = propDensityValue.getValues().empty() ? -1 : propDensityValue.get();
 
     // Save old values in order to recover them later
     if (propXAxis.getValues().size() > 0)
@@ -79,6 +143,8 @@ void ScatterPlot::updateAxisLabels()
 
     propXAxis.clearOptions();
     propYAxis.clearOptions();
+    propDensityValue.clearOptions();
+    propDensityValue.addOption("count", "Count", -1);
 
     // Extract header information for choice of columns to display
     int i = 0;
@@ -90,6 +156,7 @@ void ScatterPlot::updateAxisLabels()
             // Headers contains pairs of name and data format for each column
             propXAxis.addOption(column.first, column.first, i - 1);
             propYAxis.addOption(column.first, column.first, i - 1);
+            propDensityValue.addOption(column.first, "Sum of " + column.first, i - 1);
         }
         i++;
     }
@@ -100,13 +167,202 @@ void ScatterPlot::updateAxisLabels()
 
     propXAxis.setSelectedIndex(selectedX);
     propYAxis.setSelectedIndex(selectedY);
+    propDensityValue.setSelectedValue(selectedValue < i - 1 ? selectedValue : -1);
+}
+
+std::unique_ptr<PlotMesh> ScatterPlot::createPointMesh(const DataFrame& dataFrame,
+                                                      const Selection* selection) const
+{
+    // Get data columns but skip over the index (=first) column
+    auto dataX = dataFrame.getColumn(propXAxis.get() + 1);
+    auto dataY = dataFrame.getColumn(propYAxis.get() + 1);
+    const size_t numberOfRows = dataFrame.getNumberOfRows();
+
+    // value ranges are cached by the columns, no need to scan them again
+    auto statsX = dataX->getStatistics();
+    auto statsY = dataY->getStatistics();
+    double minX = statsX->min, maxX = statsX->max;
+    double minY = statsY->min, maxY = statsY->max;
+
+    // fetch both columns in one go instead of value by value
+    std::vector<float> valuesX(numberOfRows), valuesY(numberOfRows);
+    dataX->getValuesAsFloat(0, numberOfRows, valuesX.data());
+    dataY->getValuesAsFloat(0, numberOfRows, valuesY.data());
+
+    // One vertex per row in normalized plot coordinates, the layout is applied by PlotMesh
+    std::vector<vec2> positions(numberOfRows);
+    util::forEachRangeParallel(numberOfRows, [&](size_t begin, size_t end, size_t)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            positions[i] = vec2((valuesX[i] - minX) / (maxX - minX),
+                                (valuesY[i] - minY) / (maxY - minY));
+        }
+    }, size_t{1} << 16);
+    auto mesh = util::make_unique<PlotMesh>(std::move(positions));
+
+    // A selected subset of the rows is drawn by sharing the index buffer of the selection
+    // with the mesh, the vertices are the same in both cases
+    if (selection)
+    {
+        mesh->addIndices(Mesh::MeshInfo(DrawType::Points, ConnectivityType::None),
+                         selection->getIndexBuffer());
+    }
+    else
+    {
+        auto indexBuffer = std::make_shared<IndexBuffer>(numberOfRows);
+        auto& indices = indexBuffer->getEditableRAMRepresentation()->getDataContainer();
+        std::iota(indices.begin(), indices.end(), 0u);
+        mesh->addIndices(Mesh::MeshInfo(DrawType::Points, ConnectivityType::None), indexBuffer);
+    }
+    return mesh;
+}
+
+std::unique_ptr<PlotMesh> ScatterPlot::createDensityMesh(const DataFrame& dataFrame,
+                                                        const Selection* selection) const
+{
+    auto dataX = dataFrame.getColumn(propXAxis.get() + 1);
+    auto dataY = dataFrame.getColumn(propYAxis.get() + 1);
+    std::shared_ptr<const Column> weights;
+    if (propDensityValue.get() >= 0)
+    {
+        weights = dataFrame.getColumn(propDensityValue.get() + 1);
+    }
+
+    // Use the same value ranges as the point mode so that switching modes keeps the layout
+    auto statsX = dataX->getStatistics();
+    auto statsY = dataY->getStatistics();
+    const size2_t bins(propDensityBins.get());
+
+    std::shared_ptr<IndexBuffer> selectedRows;
+    const std::vector<std::uint32_t>* rows = nullptr;
+    if (selection)
+    {
+        selectedRows = selection->getIndexBuffer();
+        rows = &selectedRows->getRAMRepresentation()->getDataContainer();
+    }
+    const auto grid = computeDensityGrid(*dataX, *dataY, weights.get(),
+                                         dvec2(statsX->min, statsX->max),
+                                         dvec2(statsY->min, statsY->max), bins, rows);
+
+    // One quad, i.e. two triangles, per non-empty bin. The colors are interpolated between
+    // the low density and the point color by the log-scaled bin value.
+    auto indexBuffer = std::make_shared<IndexBuffer>();
+    auto& indices = indexBuffer->getEditableRAMRepresentation()->getDataContainer();
+    std::vector<vec2> positions;
+    std::vector<float> colorScale;
+    const vec2 cellSize = vec2(1.0f) / vec2(bins);
+    for (size_t y = 0; y < bins.y; ++y)
+    {
+        for (size_t x = 0; x < bins.x; ++x)
+        {
+            const size_t idx = y * bins.x + x;
+            if (grid.bins[idx] == 0.0) continue;
+
+            const vec2 corner = cellSize * vec2(x, y);
+            const auto first = static_cast<std::uint32_t>(positions.size());
+            positions.push_back(corner);
+            positions.push_back(corner + vec2(cellSize.x, 0.0f));
+            positions.push_back(corner + cellSize);
+            positions.push_back(corner + vec2(0.0f, cellSize.y));
+            colorScale.insert(colorScale.end(), 4, static_cast<float>(grid.getLogScaled(idx)));
+            for (auto i : { 0u, 1u, 2u, 0u, 2u, 3u })
+            {
+                indices.push_back(first + i);
+            }
+        }
+    }
+    auto mesh = util::make_unique<PlotMesh>(std::move(positions), std::move(colorScale));
+    mesh->addIndices(Mesh::MeshInfo(DrawType::Triangles, ConnectivityType::None), indexBuffer);
+    return mesh;
+}
+std::unique_ptr<PlotMesh> ScatterPlot::createLodMesh(const DataFrame& dataFrame,
+                                                   const Selection* selection,
+                                                   vec3 diagramOrigin, vec2 axisSize)
+{
+    if (!quadtree_)
+    {
+        auto dataX = dataFrame.getColumn(propXAxis.get() + 1);
+        auto dataY = dataFrame.getColumn(propYAxis.get() + 1);
+        auto statsX = dataX->getStatistics();
+        auto statsY = dataY->getStatistics();
+
+        std::vector<std::uint32_t> rows;
+        if (selection)
+        {
+            rows = selection->getIndexBuffer()->getRAMRepresentation()->getDataContainer();
+        }
+        const size_t count = selection ? rows.size() : dataFrame.getNumberOfRows();
+        std::vector<float> valuesX(count), valuesY(count);
+        if (selection)
+        {
+            dataX->gatherValuesAsFloat(rows.data(), count, valuesX.data());
+            dataY->gatherValuesAsFloat(rows.data(), count, valuesY.data());
+        }
+        else
+        {
+            dataX->getValuesAsFloat(0, count, valuesX.data());
+            dataY->getValuesAsFloat(0, count, valuesY.data());
+        }
+
+        // The tree works on positions normalized to [0, 1], like the point mode
+        const auto normalize = [](double v, double min, double max) {
+            return max > min ? static_cast<float>((v - min) / (max - min)) : 0.0f;
+        };
+        std::vector<vec2> positions(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            positions[i] = vec2(normalize(valuesX[i], statsX->min, statsX->max),
+                                normalize(valuesY[i], statsY->min, statsY->max));
+        }
+        quadtree_ = std::make_shared<PointQuadtree>(positions, rows);
+    }
+
+    // Map the view of the renderer from plot coordinates to normalized positions
+    const vec2 viewMin((propViewLeft.get() - diagramOrigin.x) / axisSize.x,
+                       (propViewBottom.get() - diagramOrigin.y) / axisSize.y);
+    const vec2 viewMax((propViewRight.get() - diagramOrigin.x) / axisSize.x,
+                       (propViewTop.get() - diagramOrigin.y) / axisSize.y);
+    const auto lod = quadtree_->query(viewMin, viewMax, propVertexBudget.get());
+
+    // The positions of the tree already are normalized plot coordinates
+    std::vector<vec2> vertices;
+    vertices.reserve(lod.points.size());
+    const auto& positions = quadtree_->getPositions();
+    for (auto point : lod.points)
+    {
+        vertices.push_back(positions[point]);
+    }
+    // Samples standing in for many points are colored like dense bins in density mode, i.e.
+    // log-scaled from the low density to the point color. Without any such sample, all points
+    // keep the point color.
+    std::vector<float> colorScale;
+    std::uint32_t maxCount = 1u;
+    for (auto count : lod.counts)
+    {
+        maxCount = std::max(maxCount, count);
+    }
+    if (maxCount > 1u)
+    {
+        colorScale.reserve(lod.counts.size());
+        for (auto count : lod.counts)
+        {
+            colorScale.push_back(static_cast<float>(std::log1p(static_cast<double>(count)) /
+                                                    std::log1p(static_cast<double>(maxCount))));
+        }
+    }
+    auto indexBuffer = std::make_shared<IndexBuffer>(vertices.size());
+    auto& indices = indexBuffer->getEditableRAMRepresentation()->getDataContainer();
+    std::iota(indices.begin(), indices.end(), 0u);
+    auto mesh = util::make_unique<PlotMesh>(std::move(vertices), std::move(colorScale));
+    mesh->addIndices(Mesh::MeshInfo(DrawType::Points, ConnectivityType::None), indexBuffer);
+    return mesh;
 }
 
 void ScatterPlot::process()
 {
 
-	std::ofstream myfile;
-	myfile.open("wubalubadubdub.txt");
+    DD2257_SCOPED_TIMER("ScatterPlot::process");
 
 	// origin of our plot
 	vec3 diagramOrigin(
@@ -120,72 +376,46 @@ void ScatterPlot::process()
 
 
     auto dataFrame = inData.getData();
-
-    // Get data columns but skip over the index (=first) column
-    auto dataX = dataFrame->getColumn(propXAxis.get() + 1);
-    auto dataY = dataFrame->getColumn(propYAxis.get() + 1);
-
     size_t numberOfRows = dataFrame->getNumberOfRows();
 
-    // Create a vector of vertices that we will later add to the points mesh
-    std::vector<BasicMesh::Vertex> verticesPoints;
-    auto meshPoints = std::make_shared<BasicMesh>();
-	
-
-    // Create an index buffer for the mesh. This buffer will tell the renderer
-    // which vertices are connected. For example for DrawType::Lines and 
-    // ConnectivityType::None, the renderer will take 2 indices and treat them 
-    // as a line. Then the next two indices in the buffer will be the next line.
-    // Here we just specify that we are creating a point mesh
-    // For e.g. ConnectivityType::Strip and DrawType::Lines, the first two indices 
-    // would be treated as the starting point and the following indices lead to a 
-    // strip of lines where the vertices for subsequent indices in the buffer 
-    // are connected
-    auto indexBufferPoints =
-        meshPoints->addIndexBuffer(DrawType::Points, ConnectivityType::None);
-	
-	double minX= std::numeric_limits<double>::max(), maxX= std::numeric_limits<double>::min();
-	double minY = std::numeric_limits<double>::max(), maxY = std::numeric_limits<double>::min();
-
-	for (int j = 0; j < dataX->getSize(); j++) {
-		minX= dataX->getAsDouble(j) < minX ? dataX->getAsDouble(j) : minX;
-		maxX= dataX->getAsDouble(j) > maxX ? dataX->getAsDouble(j) : maxX;
-
-		minY = dataY->getAsDouble(j) < minY ? dataY->getAsDouble(j) : minY;
-		maxY = dataY->getAsDouble(j) > maxY ? dataY->getAsDouble(j) : maxY;
-	}
-
-	myfile << "The column X has the min: " << minX << " and max: " << maxX << std::endl;
-	myfile << "The column Y has the min: " << minY << " and max: " << maxY << std::endl;
-
-    // TODO: Add points according the data within the chosen columns.
-	for (int i = 0; i < numberOfRows; i++) {
-		float x = (float)dataX->getAsDouble(i);
-		float y = (float)dataY->getAsDouble(i);
-		float px = (x - minX) / (maxX - minX);
-		float py = (y - minY) / (maxY - minY);
-
-		//add point in the mesh by squeezing it and take into account the origin (shift)
-		verticesPoints.push_back({ diagramOrigin + vec3(px*xAxisSize, py*yAxisSize, 0), vec3(0), vec3(0), propColorPoint.get() });
-		indexBufferPoints->add(static_cast<std::uint32_t>(i));
-		myfile << "Added : " << vec3(px*xAxisSize, py*yAxisSize, 0) << " on grid: " << diagramOrigin + vec3(px, py, 0)  << std::endl;
-
-	}
-
-
-    // You can access values within one column by their index
-    //size_t index = 0;
-    //float exampleValueX = (float)dataX->getAsDouble(index);
-
-    // A single vertex is defined a position, a normal, a texture coordinates and a color:
-    // {pos, norm, texcor, color}
-    // For this simple example we are only using the position and the color
-    //verticesPoints.push_back({ vec3(0.4, 0.5, 0), vec3(0), vec3(0), propColorPoint.get() });
-    // Add index of the vertex (it is the one with index 0 in the vertices vector)
-    //indexBufferPoints->add(static_cast<std::uint32_t>(0));
-
-    // Add the vertices to the mesh
-    meshPoints->addVertices(verticesPoints);
+    std::shared_ptr<const Selection> selection;
+    if (inSelection.hasData())
+    {
+        selection = inSelection.getData();
+        if (selection->getSize() != numberOfRows)
+        {
+            throw Exception("Selection does not match the number of rows of the data");
+        }
+    }
+
+    // The level of detail depends on the view and is thus built for each view, the other
+    // modes only when their data changes
+    std::unique_ptr<PlotMesh> lodPoints;
+    PlotMesh* points = nullptr;
+    if (static_cast<PlotMode>(propMode.get()) == PlotMode::Points && propLodEnabled.get())
+    {
+        lodPoints = createLodMesh(*dataFrame, selection.get(), diagramOrigin,
+                                  vec2(xAxisSize, yAxisSize));
+        points = lodPoints.get();
+    }
+    else
+    {
+        if (!points_)
+        {
+            if (static_cast<PlotMode>(propMode.get()) == PlotMode::Density)
+            {
+                points_ = createDensityMesh(*dataFrame, selection.get());
+            }
+            else
+            {
+                points_ = createPointMesh(*dataFrame, selection.get());
+            }
+        }
+        points = points_.get();
+    }
+    // Colors are only rewritten if they changed, the spacing is a transformation of the mesh
+    points->setColors(propColorPoint.get(), propColorLowDensity.get());
+    auto meshPoints = points->getMesh(vec2(diagramOrigin), vec2(xAxisSize, yAxisSize));
 
     // Create a mesh and vertex vector for the axes
     std::vector<BasicMesh::Vertex> verticesAxis;
@@ -201,16 +431,17 @@ void ScatterPlot::process()
     indexBufferLines->add(static_cast<std::uint32_t>(0));
     verticesAxis.push_back({ vec3(1 - diagramOrigin[0] , diagramOrigin[1], 0) , vec3(0), vec3(0), propColorAxes.get()});
     indexBufferLines->add(static_cast<std::uint32_t>(1));
-	myfile << "Grid x from " << diagramOrigin  << " to " << vec3(1 - diagramOrigin[0], diagramOrigin[1], 0) << std::endl;
 
 	verticesAxis.push_back({ diagramOrigin, vec3(0), vec3(0), propColorAxes.get() });
 	indexBufferLines->add(static_cast<std::uint32_t>(2));
 	verticesAxis.push_back({ vec3(diagramOrigin[0] , 1 - diagramOrigin[1], 0) , vec3(0), vec3(0), propColorAxes.get() });
 	indexBufferLines->add(static_cast<std::uint32_t>(3));
-	myfile << "Grid y from " << diagramOrigin << " to " << vec3(diagramOrigin[0], 1 - diagramOrigin[1], 0) << std::endl;
 
     meshLines->addVertices(verticesAxis);
 
+    DD2257_COUNTER("ScatterPlot::vertices", points->getNumberOfVertices());
+    DD2257_GAUGE("ScatterPlot::meshBytes", points->getSizeInBytes());
+
     // Push the meshes out
     outMeshPoints.setData(meshPoints);
     outMeshLines.setData(meshLines);
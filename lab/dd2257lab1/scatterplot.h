@@ -14,9 +14,16 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/ports/meshport.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
 #include <dd2257lab1/utils/dataframe.h>
+#include <dd2257lab1/utils/densitygrid.h>
+#include <dd2257lab1/utils/plotmesh.h>
+#include <dd2257lab1/utils/pointquadtree.h>
+#include <dd2257lab1/utils/selection.h>
 
 namespace inviwo
 {
@@ -30,6 +37,7 @@ namespace inviwo
       * __data__ DataFrame containing a number columns where the first column contains indices 
       and subsequent columns contain values for each dimension. Thus each row corresponds to 
       one data point.
+      * __selection__ Optional selection of rows, only the selected rows are drawn.
     
     ### Outports
       * __Point Mesh__ Mesh resembling the points in the scatter plot.
@@ -40,6 +48,23 @@ namespace inviwo
       * __propColorPoint__ Color for axes.
       * __propXAxis__ Currently chosen dimension (column) for the x axis.
       * __propYAxis__ Currently chosen dimension (column) for the y axis.
+      * __propMode__ Points draws one vertex per row. Density bins the rows into a 2D histogram
+      and draws one colored cell per non-empty bin, so the mesh size depends on the number of
+      bins instead of the number of rows.
+      * __propDensityBins__ Number of bins along x and y in density mode.
+      * __propDensityValue__ Bin value, either the number of rows or the sum of a column.
+      * __propColorLowDensity__ Color of the sparsest bins, the densest use the point color.
+      Colors are interpolated on a logarithmic scale.
+      * __propLod__ Level of detail in point mode. A quadtree over the points is built once per
+      data change, only points within the view are emitted. When zoomed out, dense regions
+      are represented by one sample each so that the mesh stays within the vertex budget.
+      Such samples are colored by the number of points they represent, like the bins in
+      density mode. The view properties are linked with the ones of the 2D Plot Renderer in
+      scatterplot.inv, link them likewise in other workspaces.
+
+    The points and density cells are built in normalized plot coordinates and only rebuilt
+    when the data, the selection, the axes or the density settings change. Colors and the
+    mesh spacing are applied to the cached geometry, see PlotMesh.
 */
 
 
@@ -48,6 +73,7 @@ class IVW_MODULE_DD2257LAB1_API ScatterPlot : public Processor
 //Friends
 //Types
 public:
+    enum class PlotMode { Points, Density };
 
 //Construction / Deconstruction
 public:
@@ -63,10 +89,21 @@ protected:
     ///Our main computation function
     virtual void process() override;  
     void updateAxisLabels();
+    /// Creates a point mesh with one vertex per row
+    std::unique_ptr<PlotMesh> createPointMesh(const DataFrame& dataFrame,
+                                              const Selection* selection) const;
+    /// Creates a mesh with one quad per non-empty bin of the 2D histogram of the x and y column
+    std::unique_ptr<PlotMesh> createDensityMesh(const DataFrame& dataFrame,
+                                                const Selection* selection) const;
+    /// Creates a point mesh with the level of detail of the current view, see propLod
+    std::unique_ptr<PlotMesh> createLodMesh(const DataFrame& dataFrame,
+                                            const Selection* selection,
+                                            vec3 diagramOrigin, vec2 axisSize);
 
 //Ports
 public:
     DataInport<DataFrame> inData;
+    SelectionInport inSelection;
     MeshOutport outMeshPoints;
     MeshOutport outMeshLines;
 
@@ -79,10 +116,27 @@ public:
     OptionPropertyInt propXAxis;
     OptionPropertyInt propYAxis;
 	FloatVec2Property propMeshSpacing;
+    // Density mode
+    OptionPropertyInt propMode;
+    IntVec2Property propDensityBins;
+    OptionPropertyInt propDensityValue;
+    FloatVec4Property propColorLowDensity;
+    // Level of detail in point mode
+    CompositeProperty propLod;
+    BoolProperty propLodEnabled;
+    IntSizeTProperty propVertexBudget;
+    FloatProperty propViewLeft;
+    FloatProperty propViewRight;
+    FloatProperty propViewBottom;
+    FloatProperty propViewTop;
 
 
 //Attributes
 private:
+    // Built on demand and reset whenever the data, the selection or the axes change
+    std::shared_ptr<const PointQuadtree> quadtree_;
+    // Geometry of the point and density mode, reset like the quadtree and on mode changes
+    std::unique_ptr<PlotMesh> points_;
 
 };
 
@@ -0,0 +1,500 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/aggregation.h>
+#include <dd2257lab1/utils/counterrng.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+// rows fetched from the columns at once
+constexpr size_t rowBatchSize = 4096;
+// minimum number of rows per task
+constexpr size_t minRowsPerTask = size_t{1} << 16;
+
+/**
+ * bit pattern used for comparing keys, equal values including NaN and -0.0 / +0.0 map to the
+ * same pattern
+ */
+std::uint64_t getKeyBits(double value) {
+    if (value != value) return 0x7ff8000000000000ull;
+    if (value == 0.0) return 0u;
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Writes the key bits of the values [begin, end) of a key column to dst, scratch provides
+ * space for end - begin doubles
+ */
+using KeyReader =
+    std::function<void(size_t begin, size_t end, double *scratch, std::uint64_t *dst)>;
+
+/**
+ * Returns a reader for int64 columns, which compares the values themselves. Their double
+ * representation cannot distinguish values above 2^53.
+ */
+template <typename T>
+bool tryGetIntegerKeyReader(const Column &column, KeyReader &reader) {
+    auto typed = dynamic_cast<const TemplateColumn<T> *>(&column);
+    if (!typed) return false;
+
+    // an encoded column is decoded once here rather than by each task
+    const auto values = typed->getSpan();
+    reader = [values](size_t begin, size_t end, double *, std::uint64_t *dst) {
+        for (size_t i = begin; i < end; ++i) {
+            dst[i - begin] = static_cast<std::uint64_t>(values[i]);
+        }
+    };
+    return true;
+}
+
+KeyReader getKeyReader(const Column &column) {
+    KeyReader reader;
+    if (tryGetIntegerKeyReader<std::int64_t>(column, reader)) {
+        return reader;
+    }
+    // all other column types are exact as double
+    return [&column](size_t begin, size_t end, double *scratch, std::uint64_t *dst) {
+        column.getValuesAsDouble(begin, end, scratch);
+        std::transform(scratch, scratch + (end - begin), dst,
+                       [](double value) { return getKeyBits(value); });
+    };
+}
+
+/**
+ * Running statistics of a column within a group, partial results are combined with merge()
+ * (Chan et al.)
+ */
+struct Accumulator {
+    double count = 0.0;
+    double sum = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    void add(double value) {
+        if (value != value) return;
+        count += 1.0;
+        sum += value;
+        const double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(const Accumulator &rhs) {
+        if (rhs.count == 0.0) return;
+        if (count == 0.0) {
+            *this = rhs;
+            return;
+        }
+        const double n = count + rhs.count;
+        const double delta = rhs.mean - mean;
+        mean += delta * rhs.count / n;
+        m2 += rhs.m2 + delta * delta * count * rhs.count / n;
+        count = n;
+        sum += rhs.sum;
+        min = std::min(min, rhs.min);
+        max = std::max(max, rhs.max);
+    }
+
+    double get(AggregateFunction func) const {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        switch (func) {
+            case AggregateFunction::Count:
+                return count;
+            case AggregateFunction::Sum:
+                return sum;
+            case AggregateFunction::Mean:
+                return count > 0.0 ? mean : nan;
+            case AggregateFunction::Min:
+                return count > 0.0 ? min : nan;
+            case AggregateFunction::Max:
+                return count > 0.0 ? max : nan;
+            case AggregateFunction::Variance:
+                return count > 0.0 ? m2 / count : nan;
+            default:
+                return nan;
+        }
+    }
+};
+
+/**
+ * Hash table mapping keys, i.e. keyWidth values, to groups with one accumulator per
+ * aggregated column. Open addressing with linear probing, the load factor is kept below 1/2.
+ */
+class GroupTable {
+public:
+    GroupTable(size_t keyWidth, size_t accumulatorCount)
+        : keyWidth_(keyWidth), accumulatorCount_(accumulatorCount), slots_(16, 0u) {}
+
+    size_t getSize() const { return firstRows_.size(); }
+
+    const std::uint64_t *getKey(size_t group) const { return &keys_[group * keyWidth_]; }
+    std::uint64_t getFirstRow(size_t group) const { return firstRows_[group]; }
+    Accumulator *getAccumulators(size_t group) {
+        return &accumulators_[group * accumulatorCount_];
+    }
+    const Accumulator *getAccumulators(size_t group) const {
+        return &accumulators_[group * accumulatorCount_];
+    }
+
+    /**
+     * returns the group of the given key, which is created if necessary. The first row of the
+     * group is updated to the smaller of the current one and \p row.
+     */
+    size_t findOrInsert(const std::uint64_t *key, std::uint64_t hash, std::uint64_t row) {
+        const size_t mask = slots_.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            const auto entry = slots_[slot];
+            if (entry == 0) {
+                const auto group = getSize();
+                slots_[slot] = static_cast<std::uint32_t>(group + 1);
+                keys_.insert(keys_.end(), key, key + keyWidth_);
+                hashes_.push_back(hash);
+                firstRows_.push_back(row);
+                accumulators_.resize(accumulators_.size() + accumulatorCount_);
+                if (2 * getSize() > slots_.size()) {
+                    grow();
+                }
+                return group;
+            }
+            const size_t group = entry - 1;
+            if ((hashes_[group] == hash) &&
+                std::equal(key, key + keyWidth_, keys_.begin() + group * keyWidth_)) {
+                firstRows_[group] = std::min(firstRows_[group], row);
+                return group;
+            }
+        }
+    }
+
+    void merge(const GroupTable &rhs) {
+        for (size_t i = 0; i < rhs.getSize(); ++i) {
+            const auto group = findOrInsert(rhs.getKey(i), rhs.hashes_[i], rhs.firstRows_[i]);
+            auto accumulators = getAccumulators(group);
+            const auto src = rhs.getAccumulators(i);
+            for (size_t a = 0; a < accumulatorCount_; ++a) {
+                accumulators[a].merge(src[a]);
+            }
+        }
+    }
+
+private:
+    void grow() {
+        std::vector<std::uint32_t> slots(slots_.size() * 2, 0u);
+        const size_t mask = slots.size() - 1;
+        for (size_t group = 0; group < getSize(); ++group) {
+            size_t slot = hashes_[group] & mask;
+            while (slots[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = static_cast<std::uint32_t>(group + 1);
+        }
+        slots_.swap(slots);
+    }
+
+    size_t keyWidth_;
+    size_t accumulatorCount_;
+    std::vector<std::uint64_t> keys_;
+    std::vector<std::uint64_t> hashes_;
+    std::vector<std::uint64_t> firstRows_;
+    std::vector<Accumulator> accumulators_;
+    std::vector<std::uint32_t> slots_;  // group + 1, 0 marks an empty slot
+};
+
+void checkColumn(const DataFrame &dataFrame, size_t column) {
+    if (column >= dataFrame.getNumberOfColumns()) {
+        throw Exception("DataFrame has no column " + std::to_string(column) + " (" +
+                        std::to_string(dataFrame.getNumberOfColumns()) + " columns)");
+    }
+}
+
+template <typename T>
+bool tryGatherRows(const Column &column, const std::vector<std::uint32_t> &rows,
+                   std::shared_ptr<Column> &result) {
+    auto typed = dynamic_cast<const TemplateColumn<T> *>(&column);
+    if (!typed) return false;
+
+    const auto values = typed->getSpan();
+    auto buffer = std::make_shared<Buffer<T>>(rows.size());
+    auto &dst = buffer->getEditableRAMRepresentation()->getDataContainer();
+    util::forEachRangeParallel(rows.size(),
+                               [&](size_t begin, size_t end, size_t) {
+                                   for (size_t i = begin; i < end; ++i) {
+                                       dst[i] = values[rows[i]];
+                                   }
+                               },
+                               minRowsPerTask);
+    // a clone keeps header and categories, its buffer is shared until replaced
+    std::shared_ptr<TemplateColumn<T>> gathered(typed->clone());
+    gathered->setBuffer(buffer);
+    result = gathered;
+    return true;
+}
+
+}  // namespace
+
+std::string getAggregateName(AggregateFunction func) {
+    switch (func) {
+        case AggregateFunction::Count:
+            return "count";
+        case AggregateFunction::Sum:
+            return "sum";
+        case AggregateFunction::Mean:
+            return "mean";
+        case AggregateFunction::Min:
+            return "min";
+        case AggregateFunction::Max:
+            return "max";
+        case AggregateFunction::Variance:
+        default:
+            return "variance";
+    }
+}
+
+std::shared_ptr<DataFrame> groupBy(const DataFrame &dataFrame, const std::vector<size_t> &keys,
+                                   const std::vector<Aggregation> &aggregations) {
+    DD2257_SCOPED_TIMER("groupBy");
+    for (auto key : keys) {
+        checkColumn(dataFrame, key);
+    }
+    // one accumulator per distinct column, it provides all aggregate functions
+    std::vector<size_t> valueColumns;
+    std::vector<size_t> accumulatorIndex;
+    for (const auto &aggregation : aggregations) {
+        checkColumn(dataFrame, aggregation.column);
+        auto it = std::find(valueColumns.begin(), valueColumns.end(), aggregation.column);
+        accumulatorIndex.push_back(it - valueColumns.begin());
+        if (it == valueColumns.end()) {
+            valueColumns.push_back(aggregation.column);
+        }
+    }
+
+    const size_t rows = dataFrame.getNumberOfRows();
+    const size_t keyWidth = keys.size();
+    std::vector<KeyReader> keyReaders;
+    for (auto key : keys) {
+        keyReaders.push_back(getKeyReader(*dataFrame.getColumn(key)));
+    }
+    const size_t accumulatorCount = valueColumns.size();
+
+    // each task aggregates its rows into one table per partition of the hash range, the
+    // partitions are merged independently afterwards
+    const size_t maxTasks = util::getHardwareThreadCount();
+    const size_t partitions = maxTasks;
+    std::vector<std::vector<GroupTable>> partial(maxTasks);
+
+    util::forEachRangeParallel(
+        rows,
+        [&](size_t begin, size_t end, size_t task) {
+            auto &tables = partial[task];
+            tables.assign(partitions, GroupTable(keyWidth, accumulatorCount));
+
+            std::vector<std::vector<std::uint64_t>> keyBits(
+                keyWidth, std::vector<std::uint64_t>(rowBatchSize));
+            std::vector<double> scratch(rowBatchSize);
+            std::vector<std::vector<double>> values(accumulatorCount,
+                                                    std::vector<double>(rowBatchSize));
+            std::vector<std::uint64_t> key(keyWidth);
+
+            for (size_t batch = begin; batch < end; batch += rowBatchSize) {
+                const size_t batchEnd = std::min(end, batch + rowBatchSize);
+                for (size_t k = 0; k < keyWidth; ++k) {
+                    keyReaders[k](batch, batchEnd, scratch.data(), keyBits[k].data());
+                }
+                for (size_t a = 0; a < accumulatorCount; ++a) {
+                    dataFrame.getColumn(valueColumns[a])
+                        ->getValuesAsDouble(batch, batchEnd, values[a].data());
+                }
+                for (size_t row = batch; row < batchEnd; ++row) {
+                    const size_t i = row - batch;
+                    std::uint64_t hash = 0;
+                    for (size_t k = 0; k < keyWidth; ++k) {
+                        key[k] = keyBits[k][i];
+                        hash = util::mix64(hash ^ key[k]);
+                    }
+                    auto &table = tables[(hash >> 32) % partitions];
+                    const auto group = table.findOrInsert(key.data(), hash, row);
+                    auto accumulators = table.getAccumulators(group);
+                    for (size_t a = 0; a < accumulatorCount; ++a) {
+                        accumulators[a].add(values[a][i]);
+                    }
+                }
+            }
+        },
+        minRowsPerTask, maxTasks);
+
+    std::vector<GroupTable> merged(partitions, GroupTable(keyWidth, accumulatorCount));
+    util::forEachTaskParallel(partitions, [&](size_t p) {
+        for (const auto &tables : partial) {
+            if (!tables.empty()) {
+                merged[p].merge(tables[p]);
+            }
+        }
+    });
+    partial.clear();
+
+    // order groups by first occurrence, which is independent of the partitioning
+    struct GroupRef {
+        std::uint64_t firstRow;
+        std::uint32_t partition;
+        std::uint32_t group;
+    };
+    std::vector<GroupRef> groups;
+    for (size_t p = 0; p < partitions; ++p) {
+        for (size_t g = 0; g < merged[p].getSize(); ++g) {
+            groups.push_back({merged[p].getFirstRow(g), static_cast<std::uint32_t>(p),
+                              static_cast<std::uint32_t>(g)});
+        }
+    }
+    util::parallelStableSort(groups.begin(), groups.end(),
+                             [](const GroupRef &a, const GroupRef &b) {
+                                 return a.firstRow < b.firstRow;
+                             });
+
+    auto result = std::make_shared<DataFrame>(static_cast<std::uint32_t>(groups.size()));
+
+    std::vector<std::uint32_t> firstRows(groups.size());
+    std::transform(groups.begin(), groups.end(), firstRows.begin(),
+                   [](const GroupRef &g) { return static_cast<std::uint32_t>(g.firstRow); });
+    for (auto key : keys) {
+        result->addColumn(gatherRows(*dataFrame.getColumn(key), firstRows));
+    }
+
+    for (size_t a = 0; a < aggregations.size(); ++a) {
+        const auto func = aggregations[a].func;
+        const auto header = getAggregateName(func) + "(" +
+                            dataFrame.getHeader(aggregations[a].column) + ")";
+        const size_t acc = accumulatorIndex[a];
+        auto fill = [&](auto column) {
+            auto &dst = column->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+            using ValueType = typename std::decay_t<decltype(dst)>::value_type;
+            for (size_t i = 0; i < groups.size(); ++i) {
+                const auto &g = groups[i];
+                dst[i] = static_cast<ValueType>(
+                    merged[g.partition].getAccumulators(g.group)[acc].get(func));
+            }
+        };
+        if (func == AggregateFunction::Count) {
+            fill(result->addColumn<std::int64_t>(header, groups.size()));
+        } else {
+            fill(result->addColumn<double>(header, groups.size()));
+        }
+    }
+    return result;
+}
+
+std::vector<std::uint32_t> sortRows(const DataFrame &dataFrame, const std::vector<SortKey> &keys) {
+    DD2257_SCOPED_TIMER("sortRows");
+    const size_t rows = dataFrame.getNumberOfRows();
+
+    std::vector<std::vector<double>> values;
+    for (const auto &key : keys) {
+        checkColumn(dataFrame, key.column);
+        auto column = dataFrame.getColumn(key.column);
+        values.emplace_back(rows);
+        column->getValuesAsDouble(0, rows, values.back().data());
+
+        if (auto categorical = dynamic_cast<const CategoricalColumn *>(column.get())) {
+            // replace IDs by the rank of their category
+            const auto &dict = categorical->getDictionary();
+            std::vector<std::uint32_t> ids(dict.getSize());
+            std::iota(ids.begin(), ids.end(), 0u);
+            std::sort(ids.begin(), ids.end(), [&dict](std::uint32_t a, std::uint32_t b) {
+                return std::lexicographical_compare(dict.data(a), dict.data(a) + dict.length(a),
+                                                    dict.data(b), dict.data(b) + dict.length(b));
+            });
+            std::vector<double> rank(ids.size());
+            for (size_t i = 0; i < ids.size(); ++i) {
+                rank[ids[i]] = static_cast<double>(i);
+            }
+            for (auto &v : values.back()) {
+                v = rank[static_cast<size_t>(v)];
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> order(rows);
+    std::iota(order.begin(), order.end(), 0u);
+    util::parallelStableSort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        for (size_t k = 0; k < keys.size(); ++k) {
+            const double x = values[k][a];
+            const double y = values[k][b];
+            const bool xNaN = x != x;
+            const bool yNaN = y != y;
+            if (xNaN || yNaN) {
+                if (xNaN != yNaN) return yNaN;
+                continue;
+            }
+            if (x < y) return keys[k].ascending;
+            if (y < x) return !keys[k].ascending;
+        }
+        return false;
+    });
+    return order;
+}
+
+std::shared_ptr<Column> gatherRows(const Column &column, const std::vector<std::uint32_t> &rows) {
+    std::shared_ptr<Column> result;
+    if (tryGatherRows<std::int32_t>(column, rows, result) ||
+        tryGatherRows<std::int64_t>(column, rows, result) ||
+        tryGatherRows<std::uint32_t>(column, rows, result) ||
+        tryGatherRows<float>(column, rows, result) ||
+        tryGatherRows<double>(column, rows, result)) {
+        return result;
+    }
+    throw Exception("cannot gather rows of column \"" + column.getHeader() +
+                    "\", unsupported data format");
+}
+
+std::shared_ptr<DataFrame> gatherRows(const DataFrame &dataFrame,
+                                      const std::vector<std::uint32_t> &rows) {
+    auto result = std::make_shared<DataFrame>(static_cast<std::uint32_t>(rows.size()));
+    // skip the index column, it is recreated
+    for (size_t i = 1; i < dataFrame.getNumberOfColumns(); ++i) {
+        result->addColumn(gatherRows(*dataFrame.getColumn(i), rows));
+    }
+    return result;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_AGGREGATION_H
+#define IVW_AGGREGATION_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/dataframe.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+/**
+ * \brief aggregate functions, NaN values are ignored by all of them
+ *
+ *   * __Count__     number of values
+ *   * __Variance__  population variance
+ */
+enum class AggregateFunction { Count, Sum, Mean, Min, Max, Variance };
+
+IVW_MODULE_DD2257LAB1_API std::string getAggregateName(AggregateFunction func);
+
+struct IVW_MODULE_DD2257LAB1_API Aggregation {
+    size_t column;  ///< column index in the DataFrame
+    AggregateFunction func;
+};
+
+struct IVW_MODULE_DD2257LAB1_API SortKey {
+    size_t column;  ///< column index in the DataFrame
+    bool ascending = true;
+};
+
+/**
+ * \brief groups the rows of \p dataFrame by the values of the \p keys columns and computes
+ * the given aggregations for each group. Rows are aggregated in parallel into per-thread hash
+ * tables, which are merged afterwards.
+ *
+ * The result contains the key columns, with the type of the input columns, followed by one
+ * column per aggregation named "func(header)", e.g. "mean(x)". Count results are Int64
+ * columns, all others Double. Groups are ordered by their first occurrence in the input, i.e.
+ * the order of the groups does not depend on the number of threads. The aggregated values
+ * might, since partial results of each thread are combined in floating point, e.g. sums
+ * can differ in the last bits. Int64 keys are compared by value, all other keys via their
+ * double representation, which is exact for them.
+ * Categorical columns can be aggregated, but apart from Count the results refer to the
+ * internal category IDs.
+ *
+ * @throws Exception if a column index is out of range
+ */
+IVW_MODULE_DD2257LAB1_API std::shared_ptr<DataFrame> groupBy(
+    const DataFrame &dataFrame, const std::vector<size_t> &keys,
+    const std::vector<Aggregation> &aggregations);
+
+/**
+ * \brief returns the row order sorting \p dataFrame by the given keys, the first key being
+ * the most significant one. The sort is stable, i.e. rows with equal keys keep their order.
+ * Categorical columns are sorted by their categories in lexicographical order and NaN values
+ * are placed last.
+ *
+ * @throws Exception if a column index is out of range
+ */
+IVW_MODULE_DD2257LAB1_API std::vector<std::uint32_t> sortRows(const DataFrame &dataFrame,
+                                                             const std::vector<SortKey> &keys);
+
+/**
+ * \brief returns a new column of the same type as \p column holding the values of the given
+ * rows, i.e. result[i] = column[rows[i]]. Categorical columns keep their categories.
+ */
+IVW_MODULE_DD2257LAB1_API std::shared_ptr<Column> gatherRows(
+    const Column &column, const std::vector<std::uint32_t> &rows);
+
+/**
+ * \brief returns a new DataFrame holding the given rows of \p dataFrame, \see gatherRows.
+ * The index column is renumbered.
+ */
+IVW_MODULE_DD2257LAB1_API std::shared_ptr<DataFrame> gatherRows(
+    const DataFrame &dataFrame, const std::vector<std::uint32_t> &rows);
+
+}  // namespace inviwo
+
+#endif  // IVW_AGGREGATION_H
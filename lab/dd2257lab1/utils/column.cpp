@@ -31,14 +31,24 @@
 
 namespace inviwo {
 
+std::shared_ptr<const ColumnStatistics> Column::getStatistics() const {
+    auto cached = std::atomic_load(&statistics_);
+    if (!cached || (cached->modificationCount != modificationCount_)) {
+        auto stats = std::make_shared<const ColumnStatistics>(computeStatistics());
+        cached = std::make_shared<const CachedStatistics>(
+            CachedStatistics{modificationCount_, stats});
+        std::atomic_store(&statistics_, cached);
+    }
+    return cached->statistics;
+}
+
 CategoricalColumn::CategoricalColumn(const std::string &header)
-    : TemplateColumn<std::uint32_t>(header) {}
+    : TemplateColumn<std::uint32_t>(header), dictionary_(std::make_shared<StringDictionary>()) {}
 
 CategoricalColumn *CategoricalColumn::clone() const { return new CategoricalColumn(*this); }
 
 std::string CategoricalColumn::getAsString(size_t idx) const {
-    auto index = getTypedBuffer()->getRAMRepresentation()->getDataContainer()[idx];
-    return lookUpTable_[index];
+    return dictionary_->get(TemplateColumn<std::uint32_t>::get(idx));
 }
 
 std::shared_ptr<DataPointBase> CategoricalColumn::get(size_t idx, bool getStringsAsStrings) const {
@@ -50,22 +60,73 @@ std::shared_ptr<DataPointBase> CategoricalColumn::get(size_t idx, bool getString
 }
 
 void CategoricalColumn::set(size_t idx, const std::string &str) {
-    auto id = addOrGetID(str);
-    getTypedBuffer()->getEditableRAMRepresentation()->set(idx, id);
+    auto id = addOrGetID(str.data(), str.data() + str.size());
+    getEditableValues()[idx] = id;
 }
 
 void CategoricalColumn::add(const std::string &value) {
-    auto id = addOrGetID(value);
-    getTypedBuffer()->getEditableRAMRepresentation()->add(id);
+    add(value.data(), value.data() + value.size());
+}
+
+void CategoricalColumn::add(const char *first, const char *last) {
+    auto id = addOrGetID(first, last);
+    getEditableValues().push_back(id);
+}
+
+size_t CategoricalColumn::add(const FieldView *fields, size_t count, size_t stride) {
+    auto &values = getEditableValues();
+    for (size_t i = 0; i < count; ++i, fields += stride) {
+        values.push_back(addOrGetID(fields->first, fields->second));
+    }
+    return count;
+}
+
+void CategoricalColumn::append(const Column &rhs) {
+    auto col = dynamic_cast<const CategoricalColumn *>(&rhs);
+    if (!col) {
+        throw InvalidConversion("cannot append column \"" + rhs.getHeader() +
+                                "\", data type does not match");
+    }
+    if (col == this) {
+        TemplateColumn<std::uint32_t>::append(rhs);
+        return;
+    }
+    // map IDs of rhs onto this dictionary
+    // hold on to the source dictionary, it might be shared with this column
+    const auto srcDictionary = col->dictionary_;
+    const auto &dict = *srcDictionary;
+    std::vector<glm::uint32_t> idMap;
+    idMap.reserve(dict.getSize());
+    for (StringDictionary::ID id = 0; id < dict.getSize(); ++id) {
+        idMap.push_back(addOrGetID(dict.data(id), dict.data(id) + dict.length(id)));
+    }
+    const auto srcBuffer = col->getPlainBuffer();
+    const auto &src = srcBuffer->getRAMRepresentation()->getDataContainer();
+    auto &dst = getEditableValues();
+    dst.reserve(dst.size() + src.size());
+    for (auto id : src) {
+        dst.push_back(idMap[id]);
+    }
+}
+
+size_t CategoricalColumn::getCardinality() const { return dictionary_->getSize(); }
+
+const StringDictionary &CategoricalColumn::getDictionary() const { return *dictionary_; }
+
+void CategoricalColumn::setDictionary(StringDictionary dictionary) {
+    dictionary_ = std::make_shared<StringDictionary>(std::move(dictionary));
 }
 
-glm::uint32_t CategoricalColumn::addOrGetID(const std::string &str) {
-    auto it = std::find(lookUpTable_.begin(), lookUpTable_.end(), str);
-    if (it != lookUpTable_.end()) {
-        return static_cast<glm::uint32_t>(std::distance(lookUpTable_.begin(), it));
+glm::uint32_t CategoricalColumn::addOrGetID(const char *first, const char *last) {
+    if (dictionary_.use_count() > 1) {
+        // existing categories do not require a copy of the shared dictionary
+        StringDictionary::ID id;
+        if (dictionary_->find(first, last, id)) {
+            return id;
+        }
+        dictionary_ = std::make_shared<StringDictionary>(*dictionary_);
     }
-    lookUpTable_.push_back(str);
-    return static_cast<glm::uint32_t>(lookUpTable_.size() - 1);
+    return dictionary_->addOrGetID(first, last);
 }
 
 }  // namespace inviwo
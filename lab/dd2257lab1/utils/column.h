@@ -37,7 +37,13 @@
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/util/exception.h>
 
+#include <dd2257lab1/utils/columnencoding.h>
+#include <dd2257lab1/utils/columnstatistics.h>
 #include <dd2257lab1/utils/datapoint.h>
+#include <dd2257lab1/utils/numberparser.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <dd2257lab1/utils/span.h>
+#include <dd2257lab1/utils/stringdictionary.h>
 
 namespace inviwo {
 
@@ -58,6 +64,9 @@ public:
  */
 class IVW_MODULE_DD2257LAB1_API Column {
 public:
+    /// non-owning view of a single value, i.e. the character range [first, second)
+    using FieldView = std::pair<const char *, const char *>;
+
     virtual ~Column() = default;
 
     virtual Column *clone() const = 0;
@@ -66,28 +75,139 @@ public:
     virtual void setHeader(const std::string &header) = 0;
 
     virtual void add(const std::string &value) = 0;
+    /**
+     * \brief converts the character range [first, last) and adds the result to the column
+     *
+     * Avoids the construction of a temporary string per value when the input data is already
+     * held in memory, e.g. a memory-mapped file. Numeric columns parse the range directly,
+     * categorical columns only copy it when a new category is encountered. A string is only
+     * constructed for the error message of an InvalidConversion.
+     */
+    virtual void add(const char *first, const char *last) = 0;
+    /**
+     * \brief converts up to \p count values and adds them to the column in one go. The values
+     * are taken from \p fields with a distance of \p stride, e.g. a single column of
+     * row-major data.
+     *
+     * @return number of values added. Conversion stops at the first value which cannot be
+     * converted, i.e. if less than \p count values were added, fields[result * stride] is the
+     * offending value.
+     */
+    virtual size_t add(const FieldView *fields, size_t count, size_t stride = 1) = 0;
+
+    /**
+     * \brief reserves memory for a total of \p size values
+     */
+    virtual void reserve(size_t size) = 0;
+
+    /**
+     * \brief appends all values of \p rhs to the end of this column
+     *
+     * @throws InvalidConversion if the type of \p rhs does not match this column
+     */
+    virtual void append(const Column &rhs) = 0;
 
     virtual std::shared_ptr<BufferBase> getBuffer() = 0;
     virtual std::shared_ptr<const BufferBase> getBuffer() const = 0;
 
     virtual size_t getSize() const = 0;
+    /**
+     * \brief returns the data format of the column values. Unlike getBuffer(), this does not
+     * require the values to be decoded.
+     */
+    virtual const DataFormatBase *getDataFormat() const = 0;
+
+    /**
+     * \brief returns the encoding of the column values, \see compress()
+     */
+    virtual ColumnEncoding getEncoding() const = 0;
+    /**
+     * \brief encodes the column values with the encoding requiring the least memory if it
+     * saves at least a quarter compared to plain storage, \see ColumnEncoding.
+     *
+     * Values of an encoded column are decoded batch-wise by the getValuesAs*() and
+     * gatherValuesAs*() functions. Accessing the buffer or a span decodes all values into a
+     * separate buffer, which is kept until the column is encoded again. Modifying the column
+     * reverts it to Plain.
+     *
+     * @return the selected encoding
+     */
+    virtual ColumnEncoding compress() = 0;
+    /**
+     * \brief encodes the column values with the given \p encoding
+     *
+     * @return false if the encoding is not applicable to the values, the column remains
+     * unchanged in this case
+     */
+    virtual bool setEncoding(ColumnEncoding encoding) = 0;
+    /**
+     * \brief returns the number of bytes used by the column values, including values decoded
+     * for buffer access
+     */
+    virtual size_t getMemoryUsage() const = 0;
 
     virtual double getAsDouble(size_t idx) const = 0;
     virtual dvec2 getAsDVec2(size_t idx) const = 0;
     virtual dvec3 getAsDVec3(size_t idx) const = 0;
     virtual dvec4 getAsDVec4(size_t idx) const = 0;
 
+    /**
+     * \brief converts the values [begin, end) to double and writes them to \p dst, which has
+     * to provide space for end - begin values
+     */
+    virtual void getValuesAsDouble(size_t begin, size_t end, double *dst) const = 0;
+    /// \see getValuesAsDouble
+    virtual void getValuesAsFloat(size_t begin, size_t end, float *dst) const = 0;
+    /**
+     * \brief converts the values at the given \p count indices to double and writes them to
+     * \p dst, i.e. dst[i] = value(indices[i])
+     */
+    virtual void gatherValuesAsDouble(const std::uint32_t *indices, size_t count,
+                                      double *dst) const = 0;
+    /// \see gatherValuesAsDouble
+    virtual void gatherValuesAsFloat(const std::uint32_t *indices, size_t count,
+                                     float *dst) const = 0;
+
     virtual std::string getAsString(size_t idx) const = 0;
     virtual std::shared_ptr<DataPointBase> get(size_t idx, bool getStringsAsStrings) const = 0;
 
+    /**
+     * \brief returns the statistics of the column values. They are computed on first access
+     * and cached until the column is modified, i.e. repeated calls are cheap.
+     *
+     * \see ColumnStatistics, invalidateStatistics
+     */
+    std::shared_ptr<const ColumnStatistics> getStatistics() const;
+    /**
+     * \brief discards cached statistics. This is done by all modifying member functions and
+     * when the buffer is accessed for writing through getBuffer() or getTypedBuffer(). Call
+     * this if the buffer is modified later on through a pointer obtained earlier.
+     *
+     * Copies of a column share the cached statistics until either one is modified.
+     */
+    void invalidateStatistics() { ++modificationCount_; }
+
 protected:
     Column() = default;
+
+    virtual ColumnStatistics computeStatistics() const = 0;
+
+private:
+    struct CachedStatistics {
+        size_t modificationCount;
+        std::shared_ptr<const ColumnStatistics> statistics;
+    };
+    size_t modificationCount_ = 0;
+    mutable std::shared_ptr<const CachedStatistics> statistics_;
 };
 
 /**
  * \class TemplateColumn
  * \brief Data column used for plotting which represents a named buffer of type T. The name
  * is used as column header.
+ *
+ * Copies of a column share the buffer, which is only copied when one of the columns is
+ * modified (copy-on-write). Copying a column thus costs O(1) regardless of its size.
  */
 template <typename T>
 class TemplateColumn : public Column {
@@ -111,12 +231,23 @@ public:
 
     virtual void add(const T &value);
     /** 
-     * \brief converts given value to type T, which is added to the column
+     * \brief converts given value to type T, which is added to the column. Empty values are
+     * considered missing and result in NaN for floating point columns.
      *
      * @param value   
      * @throws InvalidConversion if the value cannot be converted to T
+     * \see util::parseNumber
      */
     virtual void add(const std::string &value) override;
+    /**
+     * \brief converts the character range [first, last) to type T, which is added to the column
+     *
+     * @throws InvalidConversion if the value cannot be converted to T
+     */
+    virtual void add(const char *first, const char *last) override;
+    virtual size_t add(const FieldView *fields, size_t count, size_t stride = 1) override;
+    virtual void reserve(size_t size) override;
+    virtual void append(const Column &rhs) override;
     virtual void set(size_t idx, const T &value);
 
     T get(size_t idx) const;
@@ -139,21 +270,70 @@ public:
 
     virtual dvec4 getAsDVec4(size_t idx) const override;
 
+    virtual void getValuesAsDouble(size_t begin, size_t end, double *dst) const override;
+    virtual void getValuesAsFloat(size_t begin, size_t end, float *dst) const override;
+    virtual void gatherValuesAsDouble(const std::uint32_t *indices, size_t count,
+                                      double *dst) const override;
+    virtual void gatherValuesAsFloat(const std::uint32_t *indices, size_t count,
+                                     float *dst) const override;
+
+    /**
+     * \brief returns a view of all values of the column. The view becomes invalid when the
+     * column is modified.
+     */
+    util::Span<const T> getSpan() const;
+
     void setBuffer(std::shared_ptr<Buffer<T>> buffer);
 
     virtual std::string getAsString(size_t idx) const override;
 
+    /**
+     * \brief returns the buffer for writing. If the buffer is shared with copies of this
+     * column, it is copied first. The returned pointer must not be used for writing after the
+     * column has been copied again.
+     */
     virtual std::shared_ptr<BufferBase> getBuffer() override;
     virtual std::shared_ptr<const BufferBase> getBuffer() const override;
 
+    /// \see getBuffer()
     std::shared_ptr<Buffer<T>> getTypedBuffer();
     std::shared_ptr<const Buffer<T>> getTypedBuffer() const;
 
     virtual size_t getSize() const override;
+    virtual const DataFormatBase *getDataFormat() const override;
+
+    virtual ColumnEncoding getEncoding() const override;
+    virtual ColumnEncoding compress() override;
+    virtual bool setEncoding(ColumnEncoding encoding) override;
+    virtual size_t getMemoryUsage() const override;
 
 protected:
+    virtual ColumnStatistics computeStatistics() const override;
+
+    /**
+     * \brief copies the buffer if it is shared with another column, i.e. makes it safe to
+     * modify the buffer
+     */
+    void detach();
+    /**
+     * \brief returns the values for writing, \see detach() and invalidateStatistics()
+     */
+    std::vector<T> &getEditableValues();
+    /**
+     * \brief returns the buffer holding the plain values, which are decoded first if the
+     * column is encoded
+     */
+    std::shared_ptr<const Buffer<T>> getPlainBuffer() const;
+    /**
+     * \brief reverts the column to plain storage
+     */
+    void removeEncoding();
+    void decodeValues(std::vector<T> &dst) const;
+
     std::string header_;
-    std::shared_ptr<Buffer<T>> buffer_;
+    std::shared_ptr<Buffer<T>> buffer_;  // nullptr while the column is encoded
+    std::shared_ptr<const EncodedValues<T>> encoded_;
+    mutable std::shared_ptr<const Buffer<T>> decoded_;  // decoded values of an encoded column
 };
 
 /**
@@ -166,6 +346,8 @@ protected:
  *    by 0, 0, 1, 2.
  *    The original string values can be accessed using CategoricalColumn::get(index, true)
  *
+ * The mapping is kept in a hash-indexed StringDictionary, \see getDictionary().
+ *
  * \see TemplateColumn, \see CategoricalColumn::get()
  */
 class IVW_MODULE_DD2257LAB1_API CategoricalColumn : public TemplateColumn<std::uint32_t> {
@@ -199,11 +381,85 @@ public:
     virtual void set(size_t idx, const std::string &str);
 
     virtual void add(const std::string &value) override;
+    virtual void add(const char *first, const char *last) override;
+    virtual size_t add(const FieldView *fields, size_t count, size_t stride = 1) override;
+    /**
+     * \brief appends all values of \p rhs. Categories of \p rhs are merged into the lookup
+     * table of this column, i.e. the resulting IDs are the same as if the values were added
+     * one by one.
+     */
+    virtual void append(const Column &rhs) override;
+
+    /**
+     * \brief returns the number of distinct categories
+     */
+    size_t getCardinality() const;
+    /**
+     * \brief returns the dictionary mapping categories to their number representation, which
+     * also provides memory statistics
+     */
+    const StringDictionary &getDictionary() const;
+    /**
+     * \brief replaces the dictionary, e.g. when restoring a column from a file. All values
+     * already in the column have to be valid IDs of the new dictionary.
+     */
+    void setDictionary(StringDictionary dictionary);
 
 private:
-    virtual glm::uint32_t addOrGetID(const std::string &str);
+    glm::uint32_t addOrGetID(const char *first, const char *last);
+
+    // shared between copies of the column like the buffer, copied before adding categories
+    std::shared_ptr<StringDictionary> dictionary_;
+};
+
+/**
+ * \class ColumnBuilder
+ * \brief Collects values of a TemplateColumn in a contiguous staging buffer and commits them
+ * to the column buffer at once. Compared to TemplateColumn::add, this avoids both the virtual
+ * call and the representation lookup per value.
+ *
+ * Example:
+ *     ColumnBuilder<float> builder(dataFrame->addColumn<float>("x"), numPoints);
+ *     for (size_t i = 0; i < numPoints; ++i) {
+ *         builder.add(x[i]);
+ *     }
+ *     builder.commit();
+ *
+ * Values which have not been committed are discarded when the builder is destroyed.
+ */
+template <typename T>
+class ColumnBuilder {
+public:
+    /**
+     * @param column    target column, values are appended to its current content
+     * @param capacity  number of values to reserve in the staging buffer
+     */
+    explicit ColumnBuilder(std::shared_ptr<TemplateColumn<T>> column, size_t capacity = 0);
+    ColumnBuilder(const ColumnBuilder &) = delete;
+    ColumnBuilder &operator=(const ColumnBuilder &) = delete;
+    ~ColumnBuilder() = default;
+
+    void reserve(size_t capacity) { values_.reserve(capacity); }
+
+    void add(const T &value) { values_.push_back(value); }
+    void add(const T *first, const T *last) { values_.insert(values_.end(), first, last); }
+
+    /**
+     * \brief returns the number of staged values, which have not been committed yet
+     */
+    size_t getSize() const { return values_.size(); }
 
-    std::vector<std::string> lookUpTable_;
+    /**
+     * \brief appends all staged values to the column. The builder is empty afterwards and
+     * can be reused.
+     */
+    void commit();
+
+    std::shared_ptr<TemplateColumn<T>> getColumn() const { return column_; }
+
+private:
+    std::shared_ptr<TemplateColumn<T>> column_;
+    std::vector<T> values_;
 };
 
 template <typename T>
@@ -212,18 +468,28 @@ TemplateColumn<T>::TemplateColumn(const std::string &header)
 
 template <typename T>
 TemplateColumn<T>::TemplateColumn(const TemplateColumn &rhs)
-    : header_(rhs.getHeader())
-    , buffer_(std::shared_ptr<Buffer<T>>(rhs.getTypedBuffer()->clone())) {}
+    : Column(rhs)
+    , header_(rhs.getHeader())
+    , buffer_(rhs.buffer_)
+    , encoded_(rhs.encoded_)
+    , decoded_(std::atomic_load(&rhs.decoded_)) {}
 
 template <typename T>
 TemplateColumn<T>::TemplateColumn(TemplateColumn<T> &&rhs)
-    : header_(std::move(rhs.header_)), buffer_(std::move(rhs.buffer_)) {}
+    : Column(rhs)
+    , header_(std::move(rhs.header_))
+    , buffer_(std::move(rhs.buffer_))
+    , encoded_(std::move(rhs.encoded_))
+    , decoded_(std::move(rhs.decoded_)) {}
 
 template <typename T>
 TemplateColumn<T> &TemplateColumn<T>::operator=(const TemplateColumn<T> &rhs) {
     if (this != &rhs) {
+        Column::operator=(rhs);
         header_ = rhs.getHeader();
-        buffer_ = std::shared_ptr<Buffer<T>>(rhs.getTypedBuffer()->clone());
+        buffer_ = rhs.buffer_;
+        encoded_ = rhs.encoded_;
+        decoded_ = std::atomic_load(&rhs.decoded_);
     }
     return *this;
 }
@@ -231,8 +497,11 @@ TemplateColumn<T> &TemplateColumn<T>::operator=(const TemplateColumn<T> &rhs) {
 template <typename T>
 TemplateColumn<T> &TemplateColumn<T>::operator=(TemplateColumn<T> &&rhs) {
     if (this != &rhs) {
+        Column::operator=(rhs);
         header_ = std::move(rhs.header_);
         buffer_ = std::move(rhs.buffer_);
+        encoded_ = std::move(rhs.encoded_);
+        decoded_ = std::move(rhs.decoded_);
     }
     return *this;
 }
@@ -254,96 +523,341 @@ void TemplateColumn<T>::setHeader(const std::string &header) {
 
 template <typename T>
 void TemplateColumn<T>::add(const T &value) {
-    buffer_->getEditableRAMRepresentation()->add(value);
+    getEditableValues().push_back(value);
 }
 
 template <typename T>
 void TemplateColumn<T>::add(const std::string &value) {
+    add(value.data(), value.data() + value.size());
+}
+
+template <typename T>
+void TemplateColumn<T>::add(const char *first, const char *last) {
+    T result;
+    if (!util::parseNumber(first, last, result)) {
+        throw InvalidConversion("cannot convert \"" + std::string(first, last) +
+                                "\" to target type");
+    }
+    getEditableValues().push_back(result);
+}
+
+template <typename T>
+size_t TemplateColumn<T>::add(const FieldView *fields, size_t count, size_t stride) {
+    auto &values = getEditableValues();
     T result;
-    std::istringstream stream;
-    stream.str(value);
-    stream >> result;
-    if (stream.fail()) {
-        throw InvalidConversion("cannot convert \"" + value + "\" to target type");
+    for (size_t i = 0; i < count; ++i, fields += stride) {
+        if (!util::parseNumber(fields->first, fields->second, result)) {
+            return i;
+        }
+        values.push_back(result);
+    }
+    return count;
+}
+
+template <typename T>
+void TemplateColumn<T>::reserve(size_t size) {
+    removeEncoding();
+    detach();
+    buffer_->getEditableRAMRepresentation()->getDataContainer().reserve(size);
+}
+
+template <typename T>
+void TemplateColumn<T>::append(const Column &rhs) {
+    auto col = dynamic_cast<const TemplateColumn<T> *>(&rhs);
+    if (!col) {
+        throw InvalidConversion("cannot append column \"" + rhs.getHeader() +
+                                "\", data type does not match");
     }
-    buffer_->getEditableRAMRepresentation()->add(result);
+    // holding on to the source buffer forces a copy in getEditableValues() if it is shared
+    // with this column, including col == this. Thus, src and dst never alias.
+    const auto srcBuffer = col->getPlainBuffer();
+    const auto &src = srcBuffer->getRAMRepresentation()->getDataContainer();
+    auto &dst = getEditableValues();
+    dst.insert(dst.end(), src.begin(), src.end());
 }
 
 template <typename T>
 void TemplateColumn<T>::set(size_t idx, const T &value) {
-    buffer_->getEditableRAMRepresentation()->set(idx, value);
+    getEditableValues()[idx] = value;
 }
 
 template <typename T>
 T TemplateColumn<T>::get(size_t idx) const {
-    auto val = buffer_->getRAMRepresentation()->getDataContainer()[idx];
-    return val;
+    if (encoded_) {
+        return encoded_->get(idx);
+    }
+    return buffer_->getRAMRepresentation()->getDataContainer()[idx];
 }
 
 template <typename T>
 double TemplateColumn<T>::getAsDouble(size_t idx) const {
-    auto val = buffer_->getRAMRepresentation()->getDataContainer()[idx];
-    return util::glm_convert<double>(val);
+    return util::glm_convert<double>(get(idx));
 }
 
 template <typename T>
 dvec2 TemplateColumn<T>::getAsDVec2(size_t idx) const {
-    auto val = buffer_->getRAMRepresentation()->getDataContainer()[idx];
-    return util::glm_convert<dvec2>(val);
+    return util::glm_convert<dvec2>(get(idx));
 }
 
 template <typename T>
 dvec3 TemplateColumn<T>::getAsDVec3(size_t idx) const {
-    auto val = buffer_->getRAMRepresentation()->getDataContainer()[idx];
-    return util::glm_convert<dvec3>(val);
+    return util::glm_convert<dvec3>(get(idx));
 }
 
 template <typename T>
 dvec4 TemplateColumn<T>::getAsDVec4(size_t idx) const {
-    auto val = buffer_->getRAMRepresentation()->getDataContainer()[idx];
-    return util::glm_convert<dvec4>(val);
+    return util::glm_convert<dvec4>(get(idx));
+}
+
+namespace detail {
+
+template <typename Dst, typename T>
+void convertValues(const T *first, const T *last, Dst *dst) {
+    for (; first != last; ++first, ++dst) {
+        *dst = static_cast<Dst>(*first);
+    }
+}
+
+template <typename Dst, typename T>
+void gatherValues(const T *values, const std::uint32_t *indices, size_t count, Dst *dst) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = static_cast<Dst>(values[indices[i]]);
+    }
+}
+
+}  // namespace detail
+
+template <typename T>
+void TemplateColumn<T>::getValuesAsDouble(size_t begin, size_t end, double *dst) const {
+    if (encoded_) {
+        encoded_->decode(begin, end, dst);
+        return;
+    }
+    const T *values = buffer_->getRAMRepresentation()->getDataContainer().data();
+    detail::convertValues(values + begin, values + end, dst);
+}
+
+template <typename T>
+void TemplateColumn<T>::getValuesAsFloat(size_t begin, size_t end, float *dst) const {
+    if (encoded_) {
+        encoded_->decode(begin, end, dst);
+        return;
+    }
+    const T *values = buffer_->getRAMRepresentation()->getDataContainer().data();
+    detail::convertValues(values + begin, values + end, dst);
+}
+
+template <typename T>
+void TemplateColumn<T>::gatherValuesAsDouble(const std::uint32_t *indices, size_t count,
+                                             double *dst) const {
+    if (encoded_) {
+        encoded_->gather(indices, count, dst);
+        return;
+    }
+    const T *values = buffer_->getRAMRepresentation()->getDataContainer().data();
+    detail::gatherValues(values, indices, count, dst);
+}
+
+template <typename T>
+void TemplateColumn<T>::gatherValuesAsFloat(const std::uint32_t *indices, size_t count,
+                                            float *dst) const {
+    if (encoded_) {
+        encoded_->gather(indices, count, dst);
+        return;
+    }
+    const T *values = buffer_->getRAMRepresentation()->getDataContainer().data();
+    detail::gatherValues(values, indices, count, dst);
+}
+
+template <typename T>
+util::Span<const T> TemplateColumn<T>::getSpan() const {
+    const auto &values = getPlainBuffer()->getRAMRepresentation()->getDataContainer();
+    return util::Span<const T>(values.data(), values.size());
 }
 
 template <typename T>
 void TemplateColumn<T>::setBuffer(std::shared_ptr<Buffer<T>> buffer) {
+    invalidateStatistics();
     buffer_ = buffer;
+    encoded_.reset();
+    std::atomic_store(&decoded_, std::shared_ptr<const Buffer<T>>());
 }
 
 template <typename T>
 std::string TemplateColumn<T>::getAsString(size_t idx) const {
     std::ostringstream ss;
-    ss << buffer_->getRAMRepresentation()->get(idx);
+    ss << get(idx);
     return ss.str();
 }
 
 template <typename T>
 std::shared_ptr<DataPointBase> TemplateColumn<T>::get(size_t idx, bool) const {
-    return std::make_shared<DataPoint<T>>(buffer_->getRAMRepresentation()->get(idx));
+    return std::make_shared<DataPoint<T>>(get(idx));
 }
 
 template <typename T>
 std::shared_ptr<BufferBase> TemplateColumn<T>::getBuffer() {
-    return buffer_;
+    return getTypedBuffer();
 }
 
 template <typename T>
 std::shared_ptr<const BufferBase> TemplateColumn<T>::getBuffer() const {
-    return buffer_;
+    return getPlainBuffer();
 }
 
 template <typename T>
 std::shared_ptr<Buffer<T>> TemplateColumn<T>::getTypedBuffer() {
+    invalidateStatistics();
+    removeEncoding();
+    detach();
     return buffer_;
 }
 
 template <typename T>
 std::shared_ptr<const Buffer<T>> TemplateColumn<T>::getTypedBuffer() const {
-    return buffer_;
+    return getPlainBuffer();
 }
 
 template <typename T>
 size_t TemplateColumn<T>::getSize() const {
-    return buffer_->getSize();
+    return encoded_ ? encoded_->getSize() : buffer_->getSize();
+}
+
+template <typename T>
+const DataFormatBase *TemplateColumn<T>::getDataFormat() const {
+    return DataFormat<T>::get();
+}
+
+template <typename T>
+ColumnEncoding TemplateColumn<T>::getEncoding() const {
+    return encoded_ ? encoded_->getEncoding() : ColumnEncoding::Plain;
+}
+
+template <typename T>
+ColumnEncoding TemplateColumn<T>::compress() {
+    if (encoded_) {
+        return encoded_->getEncoding();
+    }
+    const auto &values = buffer_->getRAMRepresentation()->getDataContainer();
+    const auto encoding = EncodedValues<T>::selectEncoding(values.data(), values.size());
+    setEncoding(encoding);
+    return encoding;
+}
+
+template <typename T>
+bool TemplateColumn<T>::setEncoding(ColumnEncoding encoding) {
+    if (encoding == getEncoding()) {
+        return true;
+    }
+    if (encoding == ColumnEncoding::Plain) {
+        removeEncoding();
+        return true;
+    }
+    const auto plain = getPlainBuffer();
+    const auto &values = plain->getRAMRepresentation()->getDataContainer();
+    auto encoded = EncodedValues<T>::encode(values.data(), values.size(), encoding);
+    if (!encoded) {
+        return false;
+    }
+    // the values do not change, cached statistics remain valid
+    encoded_ = encoded;
+    buffer_.reset();
+    std::atomic_store(&decoded_, std::shared_ptr<const Buffer<T>>());
+    return true;
+}
+
+template <typename T>
+size_t TemplateColumn<T>::getMemoryUsage() const {
+    if (!encoded_) {
+        return buffer_->getSize() * sizeof(T);
+    }
+    const auto decoded = std::atomic_load(&decoded_);
+    return encoded_->getMemoryUsage() + (decoded ? decoded->getSize() * sizeof(T) : 0);
+}
+
+template <typename T>
+ColumnStatistics TemplateColumn<T>::computeStatistics() const {
+    if (encoded_ && !std::atomic_load(&decoded_)) {
+        // avoid keeping the decoded values around
+        std::vector<T> values;
+        decodeValues(values);
+        return util::computeStatistics(values.data(), values.size());
+    }
+    const auto &values = getPlainBuffer()->getRAMRepresentation()->getDataContainer();
+    return util::computeStatistics(values.data(), values.size());
+}
+
+template <typename T>
+std::shared_ptr<const Buffer<T>> TemplateColumn<T>::getPlainBuffer() const {
+    if (!encoded_) {
+        return buffer_;
+    }
+    auto decoded = std::atomic_load(&decoded_);
+    if (!decoded) {
+        auto buffer = std::make_shared<Buffer<T>>();
+        decodeValues(buffer->getEditableRAMRepresentation()->getDataContainer());
+        decoded = buffer;
+        std::atomic_store(&decoded_, decoded);
+    }
+    return decoded;
+}
+
+template <typename T>
+void TemplateColumn<T>::removeEncoding() {
+    if (!encoded_) {
+        return;
+    }
+    if (auto decoded = std::atomic_load(&decoded_)) {
+        buffer_ = std::shared_ptr<Buffer<T>>(decoded->clone());
+    } else {
+        buffer_ = std::make_shared<Buffer<T>>();
+        decodeValues(buffer_->getEditableRAMRepresentation()->getDataContainer());
+    }
+    encoded_.reset();
+    std::atomic_store(&decoded_, std::shared_ptr<const Buffer<T>>());
+}
+
+template <typename T>
+void TemplateColumn<T>::decodeValues(std::vector<T> &dst) const {
+    dst.resize(encoded_->getSize());
+    util::forEachRangeParallel(dst.size(),
+                               [&](size_t begin, size_t end, size_t) {
+                                   encoded_->decode(begin, end, dst.data() + begin);
+                               },
+                               size_t{1} << 16);
+}
+
+template <typename T>
+void TemplateColumn<T>::detach() {
+    if (buffer_.use_count() > 1) {
+        buffer_ = std::shared_ptr<Buffer<T>>(buffer_->clone());
+    }
+}
+
+template <typename T>
+std::vector<T> &TemplateColumn<T>::getEditableValues() {
+    invalidateStatistics();
+    removeEncoding();
+    detach();
+    return buffer_->getEditableRAMRepresentation()->getDataContainer();
+}
+
+template <typename T>
+ColumnBuilder<T>::ColumnBuilder(std::shared_ptr<TemplateColumn<T>> column, size_t capacity)
+    : column_(column) {
+    values_.reserve(capacity);
+}
+
+template <typename T>
+void ColumnBuilder<T>::commit() {
+    auto &dst = column_->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+    if (dst.empty()) {
+        // take over the staging buffer instead of copying it
+        dst.swap(values_);
+    } else {
+        dst.insert(dst.end(), values_.begin(), values_.end());
+    }
+    values_.clear();
 }
 
 }  // namespace inviwo
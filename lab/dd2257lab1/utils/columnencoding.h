@@ -0,0 +1,500 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_COLUMNENCODING_H
+#define IVW_COLUMNENCODING_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief storage formats of column values. All encodings are lossless.
+ *
+ *   * __Plain__             one value of type T per row
+ *   * __RunLength__         consecutive equal values are stored once together with the end
+ *                           of their run, suited for sorted or repetitive data
+ *   * __FrameOfReference__  integers are stored as differences to the column minimum using
+ *                           as few bits as the value range requires
+ *   * __Float16__           floating point values stored as half precision. Only applicable
+ *                           if all values are exactly representable, e.g. low-precision sensor
+ *                           readings
+ */
+enum class ColumnEncoding { Plain, RunLength, FrameOfReference, Float16 };
+
+inline std::string getEncodingName(ColumnEncoding encoding) {
+    switch (encoding) {
+        case ColumnEncoding::RunLength:
+            return "Run-Length";
+        case ColumnEncoding::FrameOfReference:
+            return "Frame of Reference";
+        case ColumnEncoding::Float16:
+            return "Float16";
+        case ColumnEncoding::Plain:
+        default:
+            return "Plain";
+    }
+}
+
+namespace util {
+
+/**
+ * \brief converts \p value to IEEE 754 half precision, rounding to nearest even
+ */
+inline std::uint16_t floatToHalf(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+    const auto exponent = static_cast<int>((bits >> 23) & 0xffu);
+    std::uint32_t mantissa = bits & 0x7fffffu;
+
+    if (exponent == 0xff) {  // infinity or NaN
+        return sign | 0x7c00u | (mantissa ? 0x200u : 0u);
+    }
+    const int halfExponent = exponent - 127 + 15;
+    if (halfExponent >= 31) {  // overflow
+        return sign | 0x7c00u;
+    }
+    std::uint32_t half;
+    std::uint32_t remainder;
+    std::uint32_t halfway;
+    if (halfExponent <= 0) {  // subnormal or zero
+        if (halfExponent < -10) return sign;
+        mantissa |= 0x800000u;
+        const auto shift = static_cast<std::uint32_t>(14 - halfExponent);
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1u);
+        halfway = 1u << (shift - 1u);
+    } else {
+        half = (static_cast<std::uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+        remainder = mantissa & 0x1fffu;
+        halfway = 0x1000u;
+    }
+    // a carry into the exponent yields the correct result, including infinity
+    if ((remainder > halfway) || ((remainder == halfway) && (half & 1u))) {
+        ++half;
+    }
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+namespace detail {
+
+/**
+ * Lookup tables for converting half to single precision without branches, see J. van der Zijp,
+ * "Fast Half Float Conversions". The float bits are given by
+ * mantissa[offset[h >> 10] + (h & 0x3ff)] + exponent[h >> 10], which covers zeros, subnormals,
+ * infinity, and NaN alike.
+ */
+struct HalfToFloatTables {
+    HalfToFloatTables() {
+        mantissa[0] = 0;
+        for (std::uint32_t i = 1; i < 1024; ++i) {
+            // subnormal half, normalize the mantissa
+            std::uint32_t m = i << 13;
+            std::uint32_t e = 0;
+            while ((m & 0x800000u) == 0) {
+                e -= 0x800000u;
+                m <<= 1;
+            }
+            mantissa[i] = (m & ~0x800000u) | (e + 0x38800000u);
+        }
+        for (std::uint32_t i = 1024; i < 2048; ++i) {
+            mantissa[i] = 0x38000000u + ((i - 1024) << 13);
+        }
+        for (std::uint32_t i = 0; i < 64; ++i) {
+            const std::uint32_t e = i & 0x1fu;
+            const std::uint32_t sign = (i & 0x20u) << 26;
+            exponent[i] = sign | ((e == 31) ? 0x47800000u : (e << 23));
+            offset[i] = (e == 0) ? 0u : 1024u;
+        }
+    }
+
+    std::uint32_t mantissa[2048];
+    std::uint32_t exponent[64];
+    std::uint16_t offset[64];
+};
+
+inline const HalfToFloatTables &getHalfToFloatTables() {
+    static const HalfToFloatTables tables;
+    return tables;
+}
+
+}  // namespace detail
+
+/**
+ * \brief converts the IEEE 754 half precision value \p value to float using the given lookup
+ * tables, avoids the access to the static tables when converting many values
+ */
+inline float halfToFloat(std::uint16_t value, const detail::HalfToFloatTables &tables) {
+    const std::uint32_t bits =
+        tables.mantissa[tables.offset[value >> 10] + (value & 0x3ffu)] +
+        tables.exponent[value >> 10];
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/**
+ * \brief converts the IEEE 754 half precision value \p value to float
+ */
+inline float halfToFloat(std::uint16_t value) {
+    return halfToFloat(value, detail::getHalfToFloatTables());
+}
+
+}  // namespace util
+
+/**
+ * \class EncodedValues
+ * \brief Immutable, encoded copy of the values of a column, \see ColumnEncoding. Values are
+ * decoded in batches directly into the destination, i.e. without materializing all values.
+ */
+template <typename T>
+class EncodedValues {
+public:
+    /**
+     * \brief encodes \p size values using the given encoding
+     *
+     * @return encoded values or nullptr if \p encoding is not applicable to the data or the
+     * value type, e.g. Float16 for values not representable in half precision
+     */
+    static std::shared_ptr<const EncodedValues<T>> encode(const T *values, size_t size,
+                                                          ColumnEncoding encoding);
+
+    /**
+     * \brief returns the encoding requiring the least memory for the given values. Plain is
+     * returned unless an encoding saves at least a quarter of the memory.
+     */
+    static ColumnEncoding selectEncoding(const T *values, size_t size);
+
+    ColumnEncoding getEncoding() const { return encoding_; }
+    size_t getSize() const { return size_; }
+    /**
+     * \brief number of bytes used for the encoded values
+     */
+    size_t getMemoryUsage() const;
+
+    T get(size_t idx) const;
+    /**
+     * \brief decodes the values [begin, end) and writes them to \p dst converted to Dst
+     */
+    template <typename Dst>
+    void decode(size_t begin, size_t end, Dst *dst) const;
+    /**
+     * \brief decodes the values at the given \p count indices, i.e. dst[i] = value(indices[i])
+     */
+    template <typename Dst>
+    void gather(const std::uint32_t *indices, size_t count, Dst *dst) const;
+
+private:
+    using Integral = std::is_integral<T>;
+    using Floating = std::is_floating_point<T>;
+
+    EncodedValues(ColumnEncoding encoding, size_t size) : encoding_(encoding), size_(size) {}
+
+    static bool equal(T a, T b) { return (a == b) || ((a != a) && (b != b)); }
+    static unsigned getBitWidth(std::uint64_t range);
+
+    void encodeRunLength(const T *values);
+    bool encodeFrameOfReference(const T *values, std::true_type);
+    bool encodeFrameOfReference(const T *, std::false_type) { return false; }
+    bool encodeFloat16(const T *values, std::true_type);
+    bool encodeFloat16(const T *, std::false_type) { return false; }
+
+    /// index of the run containing \p idx, searching from run \p first onwards
+    size_t findRun(size_t idx, size_t first = 0) const;
+    std::uint64_t getMask() const {
+        return bits_ == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits_) - 1;
+    }
+    /// bits starting at \p offset of \p word, continued in the next word. packed_ holds an
+    /// additional zero word at the end, so both words can be read unconditionally.
+    std::uint64_t extract(size_t word, unsigned offset) const {
+        // split shift, offset 0 would result in a shift by 64
+        return (packed_[word] >> offset) | ((packed_[word + 1] << 1) << (63 - offset));
+    }
+    std::uint64_t unpack(size_t idx) const;
+
+    ColumnEncoding encoding_;
+    size_t size_;
+
+    // run-length encoding, value and end of each run
+    std::vector<T> runValues_;
+    std::vector<std::uint64_t> runEnds_;
+
+    // frame of reference, bits_ bits per value relative to reference_
+    std::uint64_t reference_ = 0;
+    unsigned bits_ = 0;
+    std::vector<std::uint64_t> packed_;
+
+    // half precision
+    std::vector<std::uint16_t> halfs_;
+};
+
+template <typename T>
+std::shared_ptr<const EncodedValues<T>> EncodedValues<T>::encode(const T *values, size_t size,
+                                                                 ColumnEncoding encoding) {
+    std::shared_ptr<EncodedValues<T>> result(new EncodedValues<T>(encoding, size));
+    switch (encoding) {
+        case ColumnEncoding::RunLength:
+            result->encodeRunLength(values);
+            return result;
+        case ColumnEncoding::FrameOfReference:
+            return result->encodeFrameOfReference(values, Integral{}) ? result : nullptr;
+        case ColumnEncoding::Float16:
+            return result->encodeFloat16(values, Floating{}) ? result : nullptr;
+        case ColumnEncoding::Plain:
+        default:
+            return nullptr;
+    }
+}
+
+template <typename T>
+ColumnEncoding EncodedValues<T>::selectEncoding(const T *values, size_t size) {
+    if (size == 0) return ColumnEncoding::Plain;
+
+    // gather the properties of the values determining the size of each encoding in one pass
+    size_t runs = 1;
+    T minValue = values[0];
+    T maxValue = values[0];
+    bool halfExact = Floating::value;
+    for (size_t i = 0; i < size; ++i) {
+        const T v = values[i];
+        runs += (i > 0) && !equal(v, values[i - 1]);
+        minValue = std::min(minValue, v);
+        maxValue = std::max(maxValue, v);
+        if (halfExact) {
+            const float f = static_cast<float>(v);
+            const float h = util::halfToFloat(util::floatToHalf(f));
+            halfExact = (static_cast<T>(h) == v) || (v != v);
+        }
+    }
+
+    const size_t plainSize = size * sizeof(T);
+    ColumnEncoding best = ColumnEncoding::Plain;
+    size_t bestSize = plainSize - plainSize / 4;
+
+    const size_t runLengthSize = runs * (sizeof(T) + sizeof(std::uint64_t));
+    if (runLengthSize < bestSize) {
+        best = ColumnEncoding::RunLength;
+        bestSize = runLengthSize;
+    }
+    if (Integral::value) {
+        const auto range = static_cast<std::uint64_t>(maxValue) -
+                           static_cast<std::uint64_t>(minValue);
+        const size_t forSize = (size * getBitWidth(range) + 63) / 64 * sizeof(std::uint64_t);
+        if (forSize < bestSize) {
+            best = ColumnEncoding::FrameOfReference;
+            bestSize = forSize;
+        }
+    }
+    if (halfExact && (size * sizeof(std::uint16_t) < bestSize)) {
+        best = ColumnEncoding::Float16;
+    }
+    return best;
+}
+
+template <typename T>
+size_t EncodedValues<T>::getMemoryUsage() const {
+    return runValues_.size() * sizeof(T) + runEnds_.size() * sizeof(std::uint64_t) +
+           packed_.size() * sizeof(std::uint64_t) + halfs_.size() * sizeof(std::uint16_t);
+}
+
+template <typename T>
+T EncodedValues<T>::get(size_t idx) const {
+    T result;
+    decode(idx, idx + 1, &result);
+    return result;
+}
+
+template <typename T>
+template <typename Dst>
+void EncodedValues<T>::decode(size_t begin, size_t end, Dst *dst) const {
+    switch (encoding_) {
+        case ColumnEncoding::RunLength: {
+            size_t run = findRun(begin);
+            while (begin < end) {
+                const size_t runEnd = std::min<size_t>(end, runEnds_[run]);
+                std::fill(dst, dst + (runEnd - begin), static_cast<Dst>(runValues_[run]));
+                dst += runEnd - begin;
+                begin = runEnd;
+                ++run;
+            }
+            break;
+        }
+        case ColumnEncoding::FrameOfReference: {
+            if (bits_ == 0) {
+                std::fill(dst, dst + (end - begin), static_cast<Dst>(static_cast<T>(reference_)));
+                break;
+            }
+            // walk the packed words instead of locating each value from scratch
+            const std::uint64_t mask = getMask();
+            size_t word = begin * bits_ / 64;
+            auto offset = static_cast<unsigned>(begin * bits_ % 64);
+            for (size_t i = begin; i < end; ++i) {
+                const auto value = extract(word, offset) & mask;
+                *dst++ = static_cast<Dst>(static_cast<T>(reference_ + value));
+                offset += bits_;
+                word += offset / 64;
+                offset %= 64;
+            }
+            break;
+        }
+        case ColumnEncoding::Float16: {
+            const auto &tables = util::detail::getHalfToFloatTables();
+            for (size_t i = begin; i < end; ++i) {
+                *dst++ = static_cast<Dst>(util::halfToFloat(halfs_[i], tables));
+            }
+            break;
+        }
+        case ColumnEncoding::Plain:
+        default:
+            break;
+    }
+}
+
+template <typename T>
+template <typename Dst>
+void EncodedValues<T>::gather(const std::uint32_t *indices, size_t count, Dst *dst) const {
+    switch (encoding_) {
+        case ColumnEncoding::RunLength: {
+            // sorted indices mostly stay within the current run or move on to the next one,
+            // a binary search is only needed for larger steps
+            size_t run = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const std::uint64_t idx = indices[i];
+                if (idx >= runEnds_[run]) {
+                    run = (idx < runEnds_[run + 1]) ? run + 1 : findRun(idx, run + 1);
+                } else if ((run > 0) && (idx < runEnds_[run - 1])) {
+                    run = findRun(idx);
+                }
+                dst[i] = static_cast<Dst>(runValues_[run]);
+            }
+            break;
+        }
+        case ColumnEncoding::FrameOfReference:
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = static_cast<Dst>(static_cast<T>(reference_ + unpack(indices[i])));
+            }
+            break;
+        case ColumnEncoding::Float16: {
+            const auto &tables = util::detail::getHalfToFloatTables();
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = static_cast<Dst>(util::halfToFloat(halfs_[indices[i]], tables));
+            }
+            break;
+        }
+        case ColumnEncoding::Plain:
+        default:
+            break;
+    }
+}
+
+template <typename T>
+unsigned EncodedValues<T>::getBitWidth(std::uint64_t range) {
+    unsigned bits = 0;
+    while (range != 0) {
+        ++bits;
+        range >>= 1;
+    }
+    return bits;
+}
+
+template <typename T>
+void EncodedValues<T>::encodeRunLength(const T *values) {
+    for (size_t i = 0; i < size_; ++i) {
+        if (runValues_.empty() || !equal(values[i], runValues_.back())) {
+            runValues_.push_back(values[i]);
+            runEnds_.push_back(i + 1);
+        } else {
+            runEnds_.back() = i + 1;
+        }
+    }
+    runValues_.shrink_to_fit();
+    runEnds_.shrink_to_fit();
+}
+
+template <typename T>
+bool EncodedValues<T>::encodeFrameOfReference(const T *values, std::true_type) {
+    if (size_ == 0) return true;
+    const auto minmax = std::minmax_element(values, values + size_);
+    reference_ = static_cast<std::uint64_t>(*minmax.first);
+    bits_ = getBitWidth(static_cast<std::uint64_t>(*minmax.second) - reference_);
+    packed_.assign((size_ * bits_ + 63) / 64 + 1, 0u);
+    for (size_t i = 0; i < size_ && bits_ > 0; ++i) {
+        const std::uint64_t delta = static_cast<std::uint64_t>(values[i]) - reference_;
+        const size_t bit = i * bits_;
+        const size_t word = bit / 64;
+        const unsigned offset = bit % 64;
+        packed_[word] |= delta << offset;
+        if (offset + bits_ > 64) {
+            packed_[word + 1] |= delta >> (64 - offset);
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool EncodedValues<T>::encodeFloat16(const T *values, std::true_type) {
+    halfs_.resize(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const T v = values[i];
+        halfs_[i] = util::floatToHalf(static_cast<float>(v));
+        if ((static_cast<T>(util::halfToFloat(halfs_[i])) != v) && (v == v)) {
+            halfs_.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+size_t EncodedValues<T>::findRun(size_t idx, size_t first) const {
+    return static_cast<size_t>(std::upper_bound(runEnds_.begin() + first, runEnds_.end(),
+                                                static_cast<std::uint64_t>(idx)) -
+                               runEnds_.begin());
+}
+
+template <typename T>
+std::uint64_t EncodedValues<T>::unpack(size_t idx) const {
+    if (bits_ == 0) return 0;
+    const size_t bit = idx * bits_;
+    return extract(bit / 64, bit % 64) & getMask();
+}
+
+}  // namespace inviwo
+
+#endif  // IVW_COLUMNENCODING_H
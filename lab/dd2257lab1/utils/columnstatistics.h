@@ -0,0 +1,174 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_COLUMNSTATISTICS_H
+#define IVW_COLUMNSTATISTICS_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \struct ColumnStatistics
+ * \brief summary statistics of a data column. NaN values are excluded from all statistics
+ * except nanCount. If there are no valid values, min, max, mean, and variance are NaN.
+ */
+struct IVW_MODULE_DD2257LAB1_API ColumnStatistics {
+    /// number of bins of the histogram
+    static constexpr size_t histogramBins = 64;
+
+    size_t size = 0;      ///< total number of values including NaN
+    size_t nanCount = 0;  ///< number of NaN values
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+    double mean = std::numeric_limits<double>::quiet_NaN();
+    double variance = std::numeric_limits<double>::quiet_NaN();  ///< population variance
+    /// histogram of the values, the bins divide [min, max] evenly
+    std::vector<size_t> histogram = std::vector<size_t>(histogramBins, 0u);
+
+    size_t getValidCount() const { return size - nanCount; }
+};
+
+namespace util {
+
+namespace detail {
+
+// values per task used for computing statistics in parallel
+constexpr size_t statisticsRangeSize = 1u << 16;
+
+template <typename T>
+bool isNaN(T value) {
+    return std::is_floating_point<T>::value && (value != value);
+}
+
+struct PartialStatistics {
+    size_t nanCount = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0.0;    // of value - shift
+    double sumSq = 0.0;  // of (value - shift)^2
+};
+
+}  // namespace detail
+
+/**
+ * \brief computes the statistics of [data, data + size). Two passes are needed, one for
+ * min, max, and the moments and one for the histogram. Both passes run in parallel for
+ * large ranges and consist of plain loops over contiguous values, which the compiler can
+ * vectorize.
+ */
+template <typename T>
+ColumnStatistics computeStatistics(const T *data, size_t size) {
+    ColumnStatistics stats;
+    stats.size = size;
+    if (size == 0) return stats;
+
+    // moments are accumulated relative to a value within the data to reduce cancellation
+    const double shift = detail::isNaN(data[0]) ? 0.0 : static_cast<double>(data[0]);
+
+    std::vector<detail::PartialStatistics> partials(getHardwareThreadCount());
+    const size_t tasks = forEachRangeParallel(
+        size,
+        [&](size_t begin, size_t end, size_t task) {
+            detail::PartialStatistics p;
+            for (size_t i = begin; i < end; ++i) {
+                if (detail::isNaN(data[i])) {
+                    ++p.nanCount;
+                    continue;
+                }
+                const double v = static_cast<double>(data[i]);
+                p.min = std::min(p.min, v);
+                p.max = std::max(p.max, v);
+                p.sum += v - shift;
+                p.sumSq += (v - shift) * (v - shift);
+            }
+            partials[task] = p;
+        },
+        detail::statisticsRangeSize, partials.size());
+
+    detail::PartialStatistics total;
+    for (size_t i = 0; i < tasks; ++i) {
+        total.nanCount += partials[i].nanCount;
+        total.min = std::min(total.min, partials[i].min);
+        total.max = std::max(total.max, partials[i].max);
+        total.sum += partials[i].sum;
+        total.sumSq += partials[i].sumSq;
+    }
+    stats.nanCount = total.nanCount;
+    const size_t count = stats.getValidCount();
+    if (count == 0) return stats;
+
+    stats.min = total.min;
+    stats.max = total.max;
+    const double meanShifted = total.sum / static_cast<double>(count);
+    stats.mean = shift + meanShifted;
+    stats.variance =
+        std::max(0.0, total.sumSq / static_cast<double>(count) - meanShifted * meanShifted);
+
+    // histogram, infinite values end up in the first or last bin
+    const size_t bins = ColumnStatistics::histogramBins;
+    const double range = stats.max - stats.min;
+    const double scale = (range > 0.0 && std::isfinite(range)) ? bins / range : 0.0;
+    std::vector<std::vector<size_t>> histograms(tasks, std::vector<size_t>(bins, 0u));
+    forEachRangeParallel(
+        size,
+        [&](size_t begin, size_t end, size_t task) {
+            auto &histogram = histograms[task];
+            for (size_t i = begin; i < end; ++i) {
+                if (detail::isNaN(data[i])) continue;
+                const double pos = (static_cast<double>(data[i]) - stats.min) * scale;
+                const size_t bin = (pos > 0.0) ? static_cast<size_t>(std::min(
+                                                     pos, static_cast<double>(bins - 1)))
+                                               : 0u;
+                ++histogram[bin];
+            }
+        },
+        detail::statisticsRangeSize, tasks);
+    for (const auto &histogram : histograms) {
+        for (size_t bin = 0; bin < bins; ++bin) {
+            stats.histogram[bin] += histogram[bin];
+        }
+    }
+    return stats;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_COLUMNSTATISTICS_H
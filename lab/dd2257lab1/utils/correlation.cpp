@@ -0,0 +1,295 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/correlation.h>
+#include <dd2257lab1/utils/counterrng.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <dd2257lab1/utils/sortedindex.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace inviwo {
+
+namespace {
+
+// rows per block, a block of 64 columns as float fits into 256 kB
+constexpr size_t blockSize = 1024;
+
+/**
+ * Returns count rows of [0, size) in ascending order, one drawn uniformly from each of count
+ * equally sized strata
+ */
+std::vector<std::uint32_t> sampleRows(size_t size, size_t count, std::uint64_t seed) {
+    std::vector<std::uint32_t> rows(count);
+    const util::CounterRNG rng(seed);
+    const double stratum = static_cast<double>(size) / static_cast<double>(count);
+    util::forEachRangeParallel(count,
+                               [&](size_t begin, size_t end, size_t) {
+                                   for (size_t k = begin; k < end; ++k) {
+                                       const double pos = (k + rng.uniform(k)) * stratum;
+                                       rows[k] = static_cast<std::uint32_t>(
+                                           std::min(static_cast<size_t>(pos), size - 1));
+                                   }
+                               },
+                               size_t{1} << 16);
+    return rows;
+}
+
+/**
+ * Average ranks of values relative to the mean rank, NaN get the mean rank, i.e. zero. The
+ * ranks are doubled, which does not change the correlation but keeps them integral, i.e. exact
+ * as float for up to 2^24 rows.
+ */
+std::vector<float> centeredRanks(std::vector<double> values) {
+    const SortedColumnIndex index(std::move(values));
+    const auto &sorted = index.getValues();
+    const auto &rows = index.getRows();
+    const auto count = static_cast<std::int64_t>(sorted.size());
+
+    std::vector<float> ranks(index.getNumberOfRows(), 0.0f);
+    for (size_t first = 0; first < sorted.size();) {
+        size_t last = first + 1;
+        while (last < sorted.size() && sorted[last] == sorted[first]) ++last;
+        // ranks are 1-based, ties share the average rank (first + last + 1) / 2 of
+        // [first, last), the mean rank is (count + 1) / 2
+        const auto rank = static_cast<std::int64_t>(first + last) - count;
+        for (size_t k = first; k < last; ++k) {
+            ranks[rows[k]] = static_cast<float>(rank);
+        }
+        first = last;
+    }
+    return ranks;
+}
+
+/**
+ * Dot product with independent partial sums, which unlike a single sum can be vectorized
+ * without relaxed floating point semantics
+ */
+float dot(const float *a, const float *b, size_t size) {
+    constexpr size_t lanes = 8;
+    float partial[lanes] = {};
+    size_t i = 0;
+    for (; i + lanes <= size; i += lanes) {
+        for (size_t k = 0; k < lanes; ++k) {
+            partial[k] += a[i + k] * b[i + k];
+        }
+    }
+    float sum = 0.0f;
+    for (; i < size; ++i) {
+        sum += a[i] * b[i];
+    }
+    for (size_t k = 0; k < lanes; ++k) {
+        sum += partial[k];
+    }
+    return sum;
+}
+
+}  // namespace
+
+CorrelationMatrix computeCorrelationMatrix(const std::vector<const Column *> &columns,
+                                           CorrelationMethod method, size_t maxSamples,
+                                           std::uint64_t seed) {
+    DD2257_SCOPED_TIMER("computeCorrelationMatrix");
+    const size_t n = columns.size();
+    CorrelationMatrix matrix;
+    matrix.size = n;
+    matrix.values.assign(n * n, 0.0);
+    if (n == 0) return matrix;
+
+    const size_t size = columns.front()->getSize();
+    for (auto column : columns) {
+        if (column->getSize() != size) {
+            throw Exception("computeCorrelationMatrix: column \"" + column->getHeader() +
+                            "\" has " + std::to_string(column->getSize()) + " rows instead of " +
+                            std::to_string(size));
+        }
+    }
+
+    std::vector<std::uint32_t> rows;
+    const bool sampled = maxSamples > 0 && size > maxSamples;
+    if (sampled) {
+        rows = sampleRows(size, maxSamples, seed);
+    }
+    const size_t count = sampled ? rows.size() : size;
+    DD2257_COUNTER("computeCorrelationMatrix::rows", count);
+    if (count == 0) return matrix;
+
+    // Spearman needs the ranks of all rows before any block can be processed
+    std::vector<std::vector<float>> ranks;
+    if (method == CorrelationMethod::Spearman) {
+        // one column at a time, the index sorts the values of a column in parallel
+        ranks.resize(n);
+        for (size_t c = 0; c < n; ++c) {
+            std::vector<double> values(count);
+            if (sampled) {
+                columns[c]->gatherValuesAsDouble(rows.data(), count, values.data());
+            } else {
+                columns[c]->getValuesAsDouble(0, count, values.data());
+            }
+            ranks[c] = centeredRanks(std::move(values));
+        }
+    }
+    // Pearson values are shifted by the column mean for numerical stability
+    std::vector<double> means(n, 0.0);
+    if (method == CorrelationMethod::Pearson) {
+        for (size_t c = 0; c < n; ++c) {
+            const auto stats = columns[c]->getStatistics();
+            means[c] = std::isnan(stats->mean) ? 0.0 : stats->mean;
+        }
+    }
+
+    // per task sums of the values and of the products of all pairs (upper triangle)
+    const size_t blocks = (count + blockSize - 1) / blockSize;
+    const size_t maxTasks = util::getHardwareThreadCount();
+    std::vector<std::vector<double>> taskSums(maxTasks, std::vector<double>(n, 0.0));
+    std::vector<std::vector<double>> taskProducts(maxTasks, std::vector<double>(n * n, 0.0));
+    util::forEachRangeParallel(
+        blocks,
+        [&](size_t firstBlock, size_t lastBlock, size_t task) {
+            std::vector<float> block(n * blockSize);
+            std::vector<double> values(blockSize);
+            auto &sums = taskSums[task];
+            auto &products = taskProducts[task];
+            for (size_t b = firstBlock; b < lastBlock; ++b) {
+                const size_t begin = b * blockSize;
+                const size_t length = std::min(blockSize, count - begin);
+                for (size_t c = 0; c < n; ++c) {
+                    float *dst = block.data() + c * blockSize;
+                    if (!ranks.empty()) {
+                        std::copy_n(ranks[c].data() + begin, length, dst);
+                    } else {
+                        if (sampled) {
+                            columns[c]->gatherValuesAsDouble(rows.data() + begin, length,
+                                                             values.data());
+                        } else {
+                            columns[c]->getValuesAsDouble(begin, begin + length, values.data());
+                        }
+                        for (size_t r = 0; r < length; ++r) {
+                            dst[r] = std::isnan(values[r])
+                                         ? 0.0f
+                                         : static_cast<float>(values[r] - means[c]);
+                        }
+                    }
+                    sums[c] += std::accumulate(dst, dst + length, 0.0);
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    const float *a = block.data() + i * blockSize;
+                    for (size_t j = i; j < n; ++j) {
+                        products[i * n + j] += dot(a, block.data() + j * blockSize, length);
+                    }
+                }
+            }
+        },
+        1, maxTasks);
+
+    // covariance of the (shifted) values, which is not affected by the shift
+    std::vector<double> cov(n * n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i; j < n; ++j) {
+            double sumI = 0.0, sumJ = 0.0, product = 0.0;
+            for (size_t task = 0; task < maxTasks; ++task) {
+                sumI += taskSums[task][i];
+                sumJ += taskSums[task][j];
+                product += taskProducts[task][i * n + j];
+            }
+            cov[i * n + j] = product - sumI * sumJ / static_cast<double>(count);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i; j < n; ++j) {
+            const double norm = std::sqrt(cov[i * n + i] * cov[j * n + j]);
+            const double r =
+                norm > 0.0 ? std::max(-1.0, std::min(1.0, cov[i * n + j] / norm)) : 0.0;
+            matrix.values[i * n + j] = r;
+            matrix.values[j * n + i] = r;
+        }
+    }
+    return matrix;
+}
+
+std::vector<size_t> findCorrelationOrder(const CorrelationMatrix &matrix) {
+    const size_t n = matrix.size;
+    const auto weight = [&matrix](size_t i, size_t j) { return std::abs(matrix.get(i, j)); };
+    const auto pathWeight = [&weight](const std::vector<size_t> &path) {
+        double sum = 0.0;
+        for (size_t k = 1; k < path.size(); ++k) sum += weight(path[k - 1], path[k]);
+        return sum;
+    };
+
+    std::vector<size_t> best(n);
+    std::iota(best.begin(), best.end(), size_t{0});
+    if (n < 3) return best;
+
+    // nearest neighbor paths from every start column
+    double bestWeight = pathWeight(best);
+    for (size_t start = 0; start < n; ++start) {
+        std::vector<size_t> path{start};
+        std::vector<bool> visited(n, false);
+        visited[start] = true;
+        while (path.size() < n) {
+            size_t next = n;
+            for (size_t j = 0; j < n; ++j) {
+                if (visited[j]) continue;
+                if (next == n || weight(path.back(), j) > weight(path.back(), next)) next = j;
+            }
+            visited[next] = true;
+            path.push_back(next);
+        }
+        const double w = pathWeight(path);
+        if (w > bestWeight) {
+            bestWeight = w;
+            best = std::move(path);
+        }
+    }
+
+    // 2-opt: reversing path[i, j] replaces the edges (i - 1, i) and (j, j + 1)
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (size_t i = 0; i + 1 < n; ++i) {
+            for (size_t j = i + 1; j < n; ++j) {
+                double gain = 0.0;
+                if (i > 0) gain += weight(best[i - 1], best[j]) - weight(best[i - 1], best[i]);
+                if (j + 1 < n) gain += weight(best[i], best[j + 1]) - weight(best[j], best[j + 1]);
+                if (gain > 1e-12) {
+                    std::reverse(best.begin() + i, best.begin() + j + 1);
+                    improved = true;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,91 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_CORRELATION_H
+#define IVW_CORRELATION_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/column.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+enum class CorrelationMethod { Pearson, Spearman };
+
+/**
+ * \brief symmetric matrix of pairwise correlation coefficients in [-1, 1], stored row by row
+ */
+struct IVW_MODULE_DD2257LAB1_API CorrelationMatrix {
+    size_t size = 0;
+    std::vector<double> values;
+
+    double get(size_t i, size_t j) const { return values[i * size + j]; }
+};
+
+/**
+ * \brief computes the correlation of all pairs of \p columns.
+ *
+ * The rows are processed in blocks, each block of all columns is converted to float once and
+ * fits into the cache while the dot products of all column pairs are accumulated. Blocks are
+ * distributed over threads, the inner loops are plain dot products suitable for automatic
+ * vectorization. NaN values are replaced by the column mean, i.e. they do not contribute to
+ * the covariance. Constant columns have a correlation of zero with all other columns.
+ *
+ * Spearman correlation is the Pearson correlation of the ranks, tied values get their average
+ * rank. The values of each column are sorted in parallel by a SortedColumnIndex. The ranks of
+ * all columns are kept in memory, i.e. 4 bytes per row and column, and are exact for up to
+ * 2^24 rows.
+ *
+ * @param maxSamples  if not zero and the columns have more rows, the correlation is estimated
+ *                    from maxSamples rows drawn by stratified random sampling. The standard
+ *                    error of a coefficient is about 1 / sqrt(maxSamples).
+ * @param seed        seed of the sampling, equal seeds yield equal results
+ * @throws Exception if the columns differ in size
+ */
+IVW_MODULE_DD2257LAB1_API CorrelationMatrix
+computeCorrelationMatrix(const std::vector<const Column *> &columns, CorrelationMethod method,
+                         size_t maxSamples = 0, std::uint64_t seed = 0);
+
+/**
+ * \brief returns an order of the columns of \p matrix maximizing the sum of the absolute
+ * correlation of neighbors, e.g. of adjacent axes in parallel coordinates.
+ *
+ * This is a maximum weight Hamiltonian path, i.e. a traveling salesman problem. The best
+ * nearest neighbor path over all start columns is improved by 2-opt moves until no reversal
+ * of a part of the path increases the sum.
+ */
+IVW_MODULE_DD2257LAB1_API std::vector<size_t> findCorrelationOrder(
+    const CorrelationMatrix &matrix);
+
+}  // namespace inviwo
+
+#endif  // IVW_CORRELATION_H
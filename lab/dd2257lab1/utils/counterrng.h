@@ -0,0 +1,96 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_COUNTERRNG_H
+#define IVW_COUNTERRNG_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief finalizer of splitmix64, a bijective mixing of all bits of \p z. Used for random
+ * numbers as well as for hashing.
+ */
+inline std::uint64_t mix64(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * \class CounterRNG
+ * \brief Counter-based random number generator, i.e. the n-th number of a stream is computed
+ * directly from the seed, the stream, and n without any state. The result does not depend on
+ * the order of evaluation, which allows to generate reproducible random numbers in parallel.
+ *
+ * Each stream is a splitmix64 sequence with a key derived from seed and stream.
+ */
+class CounterRNG {
+public:
+    explicit CounterRNG(std::uint64_t seed, std::uint64_t stream = 0)
+        : key_(mix64(mix64(seed) ^ (stream * gamma + 0x632be59bd9b4e019ull))) {}
+
+    /**
+     * \brief returns the \p counter-th random number of the stream
+     */
+    std::uint64_t operator()(std::uint64_t counter) const {
+        return mix64(key_ + counter * gamma);
+    }
+
+    /**
+     * \brief returns a uniformly distributed number in [0, 1)
+     */
+    double uniform(std::uint64_t counter) const {
+        return static_cast<double>((*this)(counter) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * \brief returns a uniformly distributed integer in [0, n)
+     */
+    std::uint32_t uniformInt(std::uint64_t counter, std::uint32_t n) const {
+        return static_cast<std::uint32_t>((((*this)(counter) >> 32) * n) >> 32);
+    }
+
+private:
+    static constexpr std::uint64_t gamma = 0x9e3779b97f4a7c15ull;
+
+    std::uint64_t key_;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_COUNTERRNG_H
@@ -30,126 +30,499 @@
 #include <dd2257lab1/utils/csvreader.h>
 
 #include <dd2257lab1/utils/column.h>
+#include <dd2257lab1/utils/csvscanner.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/memorymappedfile.h>
+#include <dd2257lab1/utils/parallel.h>
 #include <inviwo/core/util/filesystem.h>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 
 namespace inviwo {
 
-CSVReader::CSVReader() : delimiters_(","), firstRowHeader_(true) {}
+namespace {
 
-CSVReader* CSVReader::clone() const { return new CSVReader(*this); }
-
-void CSVReader::setDelimiters(const std::string& delim) { delimiters_ = delim; }
-
-void CSVReader::setFirstRowHeader(bool hasHeader) {
-    firstRowHeader_ = true;
-}
-
-std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
-    std::ifstream file(fileName);
+/**
+ * Splits a character range into rows and fields without copying any data. The returned
+ * fields point directly into the input, enclosing quotes are kept as part of the value.
+ * Instead of testing each character, the tokenizer jumps between the structural characters
+ * reported by the CSVStructuralScanner.
+ */
+class CSVTokenizer {
+public:
+    using FieldView = DataFrame::FieldView;
 
-    if (!file.is_open()) {
-        throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."));
+    CSVTokenizer(const char *begin, const char *end, const std::string &delimiters,
+                 size_t firstLine = 1u)
+        : cur_(begin)
+        , end_(end)
+        , line_(firstLine)
+        , eof_(false)
+        , isDelimiter_()
+        , scanner_(begin, end, delimiters) {
+        for (auto ch : delimiters) {
+            isDelimiter_[static_cast<unsigned char>(ch)] = true;
+        }
     }
 
-    file.seekg(0, std::ios::end);
-    std::streampos len = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<char> buffer(len);
-    // read in entire file
-    file.read(buffer.data(), len);
+    /**
+     * \brief extracts the next row into \p row, reusing its memory
+     * @return false if the end of the input has been reached and there is no more data
+     */
+    bool nextRow(std::vector<FieldView> &row) {
+        row.clear();
+        bool endOfRow = false;
+        auto field = nextField(endOfRow);
+        if (eof_ && (field.first == field.second)) {
+            // reached end of file, no more data
+            return false;
+        }
+        row.push_back(field);
+        while (!endOfRow && !eof_) {
+            row.push_back(nextField(endOfRow));
+        }
+        return true;
+    }
 
-    // create a string stream for easier handling
-    std::stringstream in(buffer.data());
-    //in.rdbuf()->pubsetbuf(buffer.data(), len);
+    void skipEmptyLines() {
+        while ((cur_ != end_) && (*cur_ == '\n')) {
+            ++cur_;
+        }
+    }
 
-    // current line
-    size_t line = 1u;
+    const char *position() const { return cur_; }
+    size_t getLine() const { return line_; }
 
-    auto extractColumn = [&]() -> std::pair<std::string, bool> {
-        std::string value;
-        size_t quoteCount = 0;
-        char prev = 0;
-        const size_t startLine = line;
+private:
+    FieldView nextField(bool &endOfRow) {
         // ignore empty lines
-        while (!in.eof() && (in.peek() == '\n')) {
-            in.get();
-        }
-        char ch;
-        while (in.get(ch)) {
+        skipEmptyLines();
+        const char *first = cur_;
+        const size_t startLine = line_;
+        size_t quoteCount = 0;
+        for (const char *pos = scanner_.next(cur_); pos != end_; pos = scanner_.next(cur_)) {
+            const char ch = *pos;
+            // the character preceding the structural one within the current field
+            const char prev = (pos != first) ? *(pos - 1) : 0;
+            cur_ = pos + 1;
             if (ch == '\n') {
-                ++line;  // increase line counter
+                ++line_;
                 // consume line break, if inside quotes
                 if ((quoteCount & 1) != 0) {
-                    value += ch;
-                    prev = ch;
                     continue;
                 }
             }
             if (ch == '"') {
                 ++quoteCount;
-            } else if (util::contains(delimiters_, ch) || (ch == '\n')) {
+            } else if (isDelimiter_[static_cast<unsigned char>(ch)] || (ch == '\n')) {
                 // found a delimiter/newline, ensure that it isn't enclosed by quotes,
                 // i.e. an even count of quotes
                 if ((quoteCount == 0) || ((prev == '"') && ((quoteCount & 1) == 0))) {
-                    return{ value, (ch == '\n') };
+                    endOfRow = (ch == '\n');
+                    return {first, pos};
                 }
             }
-            prev = ch;
-            value += ch;
         }
-        if (((quoteCount & 1) != 0) && in.eof()) {
-            throw Exception("CSVReader: unmatched quotes (line " + std::to_string(startLine) + ")");
+        cur_ = end_;
+        eof_ = true;
+        if ((quoteCount & 1) != 0) {
+            throw Exception("CSVReader: unmatched quotes (line " + std::to_string(startLine) +
+                            ")");
         }
-        return {value, false};
-    };
+        endOfRow = false;
+        return {first, end_};
+    }
 
-    auto extractRow = [&]() -> std::vector<std::string> {        
-        auto val = extractColumn();
-        if (in.eof() && val.first.empty()) {
-            // reached end of file, no more data
-            return{};
+    const char *cur_;
+    const char *end_;
+    size_t line_;
+    bool eof_;
+    std::array<bool, 256> isDelimiter_;
+    CSVStructuralScanner scanner_;
+};
+
+// chunks smaller than this are not worth the overhead of an additional thread
+constexpr size_t minChunkSize = 1u << 20;
+// number of rows used for determining the column types
+constexpr size_t typeInferenceRows = 1000;
+// number of rows which are converted together, column by column
+constexpr size_t rowBatchSize = 4096;
+
+/**
+ * Collects rows in a contiguous buffer and adds them to a DataFrame in batches, i.e. one
+ * conversion call per column and batch instead of one per value.
+ */
+class RowBatcher {
+public:
+    explicit RowBatcher(DataFrame &dataFrame)
+        : dataFrame_(dataFrame), columns_(dataFrame.getNumberOfColumns() - 1), rows_(0) {
+        fields_.reserve(columns_ * rowBatchSize);
+    }
+
+    /**
+     * Adds a row to the current batch, which is flushed once it is full.
+     * Returns true if the batch was flushed.
+     */
+    bool add(const std::vector<DataFrame::FieldView> &row) {
+        if (row.size() != columns_) {
+            throw InvalidColCount("DataFrame: data does not match column count");
         }
-        std::vector<std::string> values;
-        values.push_back(val.first);
-        while (!val.second && !in.eof()) {
-            val = extractColumn();
-            values.push_back(val.first);
+        fields_.insert(fields_.end(), row.begin(), row.end());
+        ++rows_;
+        if (fields_.size() >= columns_ * rowBatchSize) {
+            flush();
+            return true;
         }
-        return values;
-    };
+        return false;
+    }
+
+    void flush() {
+        if (!fields_.empty()) {
+            dataFrame_.addRows(fields_);
+            fields_.clear();
+        }
+    }
+
+    /// total number of rows added so far, including rows not flushed yet
+    size_t getNumberOfRows() const { return rows_; }
+
+private:
+    DataFrame &dataFrame_;
+    const size_t columns_;
+    size_t rows_;
+    std::vector<DataFrame::FieldView> fields_;
+};
+
+/**
+ * Estimates the number of rows in [first, last) given that the first \p rows rows take up
+ * \p bytes bytes.
+ */
+size_t estimateRowCount(const char *first, const char *last, size_t rows, size_t bytes) {
+    if ((rows == 0) || (bytes == 0)) return 0;
+    return static_cast<size_t>(static_cast<double>(last - first) * rows / bytes);
+}
+
+/**
+ * Splits [first, last) into at most chunkCount chunks, each starting at the beginning of a
+ * record. Nominal split points are moved forward past the next line break which is not
+ * enclosed in quotes. Quote parity at the split points is determined by counting quotes of
+ * each chunk in parallel. Returns the chunk starts followed by last.
+ */
+std::vector<const char *> findRecordBoundaries(const char *first, const char *last,
+                                               size_t chunkCount) {
+    const size_t size = static_cast<size_t>(last - first);
+    auto nominal = [&](size_t i) { return first + size * i / chunkCount; };
+
+    std::vector<size_t> quoteCounts(chunkCount, 0u);
+    util::forEachTaskParallel(chunkCount, [&](size_t i) {
+        quoteCounts[i] =
+            static_cast<size_t>(std::count(nominal(i), nominal(i + 1), '"'));
+    });
+
+    std::vector<const char *> boundaries{first};
+    size_t quoteCount = 0;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        quoteCount += quoteCounts[i - 1];
+        bool inQuotes = (quoteCount & 1) != 0;
+        const char *it = nominal(i);
+        while (it != last) {
+            const char ch = *it++;
+            if (ch == '"') {
+                inQuotes = !inQuotes;
+            } else if ((ch == '\n') && !inQuotes) {
+                break;
+            }
+        }
+        // empty lines are skipped by the tokenizer anyway
+        while ((it != last) && (*it == '\n')) {
+            ++it;
+        }
+        if ((it != last) && (it > boundaries.back())) {
+            boundaries.push_back(it);
+        }
+    }
+    boundaries.push_back(last);
+    return boundaries;
+}
+
+}  // namespace
+
+CSVReader::CSVReader()
+    : delimiters_(","), firstRowHeader_(true), useMemoryMapping_(true), numThreads_(0) {}
+
+CSVReader* CSVReader::clone() const { return new CSVReader(*this); }
+
+void CSVReader::setDelimiters(const std::string& delim) { delimiters_ = delim; }
+
+void CSVReader::setFirstRowHeader(bool hasHeader) {
+    firstRowHeader_ = hasHeader;
+}
+
+void CSVReader::setUseMemoryMapping(bool useMapping) { useMemoryMapping_ = useMapping; }
+
+void CSVReader::setNumberOfThreads(size_t threads) { numThreads_ = threads; }
+
+std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
+    return readData(fileName, 0u, nullptr);
+}
+
+std::shared_ptr<DataFrame> CSVReader::readData(const std::string &fileName, size_t batchSize,
+                                               const BatchCallback &callback,
+                                               const std::atomic<bool> *cancel) {
+    DD2257_SCOPED_TIMER("CSVReader::readData");
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    std::vector<char> buffer;
+    const char *first = nullptr;
+    const char *last = nullptr;
+
+    if (useMemoryMapping_) {
+        try {
+            mappedFile = util::make_unique<MemoryMappedFile>(fileName);
+        } catch (FileException &) {
+            throw FileException(
+                std::string("CSVReader: Could not open file \"" + fileName + "\"."));
+        }
+        first = mappedFile->begin();
+        last = mappedFile->end();
+    } else {
+        std::ifstream file(fileName, std::ios::in | std::ios::binary);
+
+        if (!file.is_open()) {
+            throw FileException(
+                std::string("CSVReader: Could not open file \"" + fileName + "\"."));
+        }
+
+        file.seekg(0, std::ios::end);
+        std::streampos len = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        // read in entire file
+        buffer.resize(static_cast<size_t>(len));
+        file.read(buffer.data(), len);
+        first = buffer.data();
+        last = buffer.data() + buffer.size();
+    }
+
+    CSVTokenizer tokenizer(first, last, delimiters_);
+
+    std::vector<DataFrame::FieldView> row;
 
     std::vector<std::string> headers;
     if (firstRowHeader_) {
         // read headers
-        headers = extractRow();
-        if (headers.empty()) {
+        if (!tokenizer.nextRow(row)) {
             throw Exception("CSVReader: no column headers found.");
         }
+        for (auto &field : row) {
+            headers.emplace_back(field.first, field.second);
+        }
     }
 
-    std::vector<std::string> data = extractRow();
-    if (data.empty()) {
+    // figure out column types from the first rows, types are widened later on if necessary
+    std::vector<std::vector<DataFrame::FieldView>> sample;
+    const char *sampleStart = tokenizer.position();
+    while ((sample.size() < typeInferenceRows) && tokenizer.nextRow(row)) {
+        sample.push_back(row);
+    }
+    if (sample.empty()) {
         throw Exception("CSVReader: empty file, no data");
     }
 
     if (!firstRowHeader_) {
         // assign default column headers
-        for (size_t i = 0; i < data.size(); ++i) {
+        for (size_t i = 0; i < sample.front().size(); ++i) {
             headers.push_back(std::string("Column ") + std::to_string(i + 1));
         }
     }
-    // figure out column types
-    auto dataFrame = createDataFrame(data, headers);
-    
-    while (!data.empty()) {
-        dataFrame->addRow(data);
 
-        data = extractRow();
+    std::vector<ColumnType> types;
+    for (auto &field : sample.front()) {
+        types.push_back(detectColumnType(field.first, field.second));
+    }
+    for (auto &sampleRow : sample) {
+        for (size_t i = 0; i < std::min(types.size(), sampleRow.size()); ++i) {
+            types[i] = widenColumnType(
+                types[i], detectColumnType(sampleRow[i].first, sampleRow[i].second));
+        }
+    }
+
+    const char *dataStart = tokenizer.position();
+    const size_t dataLine = tokenizer.getLine();
+    // bytes per row of the sample are used for reserving memory up front
+    auto estimateRows = [&](const char *begin, const char *end) {
+        return estimateRowCount(begin, end, sample.size(),
+                                static_cast<size_t>(dataStart - sampleStart));
+    };
+
+    // Widening a numeric column to categorical after the sample could only recreate the text
+    // of the values parsed so far from their numbers, e.g. "007" would become "7" and blank
+    // cells "nan". Instead, parsing starts over after the sample with the affected columns
+    // declared categorical from the outset. Each restart adds at least one categorical column.
+    bool restart = false;
+    auto updateTypes = [&](const DataFrame &frame) {
+        for (size_t i = 0; i < types.size(); ++i) {
+            if ((types[i] != ColumnType::Categorical) &&
+                (getColumnType(*frame.getColumn(i + 1)) == ColumnType::Categorical)) {
+                types[i] = ColumnType::Categorical;
+                restart = true;
+            }
+        }
+        return restart;
+    };
+
+    auto parseRows = [&]() -> std::shared_ptr<DataFrame> {
+        auto dataFrame = createDataFrame(types, headers);
+        RowBatcher batcher(*dataFrame);
+        for (auto &sampleRow : sample) {
+            batcher.add(sampleRow);
+        }
+        batcher.flush();
+        CSVTokenizer dataTokenizer(dataStart, last, delimiters_, dataLine);
+
+        if (callback) {
+            dataFrame->reserve(estimateRows(sampleStart, last));
+            size_t nextBatch = std::max<size_t>(batchSize, 1u);
+            auto emitBatch = [&]() {
+                if (batcher.getNumberOfRows() >= nextBatch) {
+                    batcher.flush();
+                    auto batch = std::make_shared<DataFrame>(*dataFrame);
+                    batch->updateIndexBuffer();
+                    callback(batch);
+                    while (nextBatch <= batcher.getNumberOfRows()) nextBatch *= 2;
+                }
+            };
+            emitBatch();
+            while (dataTokenizer.nextRow(row)) {
+                if (batcher.add(row) || (batcher.getNumberOfRows() >= nextBatch)) {
+                    if (cancel && cancel->load()) {
+                        return nullptr;
+                    }
+                    // never report a batch with a column converted to categorical
+                    batcher.flush();
+                    if (updateTypes(*dataFrame)) {
+                        return nullptr;
+                    }
+                    emitBatch();
+                }
+            }
+            batcher.flush();
+            if (updateTypes(*dataFrame)) {
+                return nullptr;
+            }
+            dataFrame->updateIndexBuffer();
+            return dataFrame;
+        }
+
+        auto parseSerial = [&]() -> std::shared_ptr<DataFrame> {
+            dataFrame->reserve(estimateRows(sampleStart, last));
+            while (dataTokenizer.nextRow(row)) {
+                // stop early, the rows are parsed again anyway
+                if (batcher.add(row) && updateTypes(*dataFrame)) {
+                    return nullptr;
+                }
+            }
+            batcher.flush();
+            if (updateTypes(*dataFrame)) {
+                return nullptr;
+            }
+            dataFrame->updateIndexBuffer();
+            return dataFrame;
+        };
+
+        const size_t threads = (numThreads_ == 0) ? util::getHardwareThreadCount() : numThreads_;
+        const size_t chunkCount =
+            std::min(threads, static_cast<size_t>(last - dataStart) / minChunkSize);
+        if (chunkCount <= 1) {
+            return parseSerial();
+        }
+
+        // parse the remaining rows in parallel, each chunk into its own fragment
+        const auto boundaries = findRecordBoundaries(dataStart, last, chunkCount);
+        const size_t fragmentCount = boundaries.size() - 1;
+        std::vector<std::shared_ptr<DataFrame>> fragments(fragmentCount);
+        std::vector<const char *> fragmentEnds(fragmentCount, nullptr);
+
+        bool consistent = true;
+        try {
+            util::forEachTaskParallel(fragmentCount, [&](size_t i) {
+                auto fragment = createDataFrame(types, headers);
+                fragment->reserve(estimateRows(boundaries[i], boundaries[i + 1]));
+                RowBatcher chunkBatcher(*fragment);
+                CSVTokenizer chunkTokenizer(boundaries[i], last, delimiters_);
+                std::vector<DataFrame::FieldView> chunkRow;
+                // rows starting within the chunk are parsed completely, even if they extend
+                // beyond the end of the chunk
+                chunkTokenizer.skipEmptyLines();
+                while ((chunkTokenizer.position() < boundaries[i + 1]) &&
+                       chunkTokenizer.nextRow(chunkRow)) {
+                    chunkBatcher.add(chunkRow);
+                    chunkTokenizer.skipEmptyLines();
+                }
+                chunkBatcher.flush();
+                fragmentEnds[i] = chunkTokenizer.position();
+                fragments[i] = fragment;
+            });
+            // each fragment has to end exactly where the next one starts. Otherwise a record
+            // boundary was misplaced, e.g. due to unbalanced quotes or lines ending in
+            // delimiters.
+            for (size_t i = 0; i < fragmentCount; ++i) {
+                consistent &= (fragmentEnds[i] == boundaries[i + 1]);
+            }
+        } catch (Exception &) {
+            // errors might be caused by misplaced boundaries as well, the serial parse either
+            // succeeds or reports the error with the correct line number
+            consistent = false;
+        }
+
+        if (!consistent) {
+            fragments.clear();
+            return parseSerial();
+        }
+        for (auto &fragment : fragments) {
+            updateTypes(*fragment);
+        }
+        if (restart) {
+            return nullptr;
+        }
+
+        // stitch fragments together, columns are independent of each other. Fragments might
+        // have widened numeric columns independently, all of them are converted to the widest
+        // type.
+        const size_t numCols = dataFrame->getNumberOfColumns();
+        util::forEachRangeParallel(numCols - 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t col = begin + 1; col < end + 1; ++col) {
+                auto type = getColumnType(*dataFrame->getColumn(col));
+                for (auto &fragment : fragments) {
+                    type = widenColumnType(type, getColumnType(*fragment->getColumn(col)));
+                }
+                dataFrame->widenColumn(col, type);
+                auto column = dataFrame->getColumn(col);
+                size_t size = column->getSize();
+                for (auto &fragment : fragments) {
+                    size += fragment->getColumn(col)->getSize();
+                }
+                column->reserve(size);
+                // hand over each fragment column and drop it right after appending, otherwise
+                // all fragments stay alive until the end and peak memory doubles
+                for (auto &fragment : fragments) {
+                    fragment->widenColumn(col, type);
+                    column->append(*fragment->releaseColumn(col));
+                }
+            }
+        }, 1u, threads);
+
+        dataFrame->updateIndexBuffer();
+        return dataFrame;
+    };
+
+    auto dataFrame = parseRows();
+    while (restart) {
+        DD2257_COUNTER("CSVReader::categoricalRestarts", 1);
+        restart = false;
+        dataFrame = parseRows();
     }
-    dataFrame->updateIndexBuffer();
     return dataFrame;
 }
 
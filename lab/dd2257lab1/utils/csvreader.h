@@ -36,6 +36,9 @@
 #include <inviwo/core/io/datareader.h>
 #include <dd2257lab1/utils/dataframe.h>
 
+#include <atomic>
+#include <functional>
+
 namespace inviwo {
 
 /**
@@ -43,6 +46,21 @@ namespace inviwo {
  * \ingroup dataio
  *
  * \brief A reader for comma separated value (CSV) files with customizable delimiters.
+ *
+ * By default, the file is memory-mapped and tokenized in place. Values are only converted
+ * when they are added to the columns of the resulting DataFrame, no intermediate copies of
+ * the file content or individual values are created.
+ *
+ * Large files are parsed in parallel. The input is split into chunks at record boundaries
+ * outside of quotes, each chunk is parsed into a separate DataFrame fragment and the fragments
+ * are stitched together in order.
+ *
+ * Column types are inferred from the first rows and widened as needed. Numeric columns are
+ * widened in place. If a numeric column has to become categorical, the rows are parsed again
+ * with that column declared categorical, so categories always hold the text of the file.
+ *
+ * For progressive loading, intermediate results can be reported while parsing, \see
+ * readData(const std::string&, size_t, const BatchCallback&, const std::atomic<bool>*)
  */
 class IVW_MODULE_DD2257LAB1_API CSVReader : public DataReaderType<DataFrame> { 
 public:
@@ -56,12 +74,44 @@ public:
 
     void setDelimiters(const std::string &delim);
     void setFirstRowHeader(bool hasHeader);
+    /**
+     * \brief toggles between mapping the file into memory (default) and reading it into a
+     * private buffer. The latter might be preferable for files on network shares.
+     */
+    void setUseMemoryMapping(bool useMapping);
+    /**
+     * \brief sets the maximum number of threads used for parsing. 0 (default) refers to the
+     * number of hardware threads, 1 disables parallel parsing.
+     */
+    void setNumberOfThreads(size_t threads);
 
     virtual std::shared_ptr<DataFrame> readData(const std::string& fileName) override;
 
+    using BatchCallback = std::function<void(std::shared_ptr<DataFrame>)>;
+    /**
+     * \brief reads the file and reports intermediate results while parsing. The callback is
+     * called with a copy of all rows read so far, first after \p batchSize rows and then each
+     * time the number of rows has doubled. Growing the batches geometrically keeps the total
+     * cost of all copies linear in the file size. The complete DataFrame is returned and not
+     * passed to the callback. Files are always parsed serially in this mode. If a column
+     * turns out to hold text only after the rows used for type inference, parsing starts over
+     * to keep the original text and the reported row counts start over as well.
+     *
+     * @param fileName   CSV file
+     * @param batchSize  number of rows in the first batch
+     * @param callback   called for each batch from the calling thread
+     * @param cancel     optional flag, parsing stops as soon as it is set
+     * @return the entire DataFrame or nullptr if parsing was canceled
+     */
+    std::shared_ptr<DataFrame> readData(const std::string &fileName, size_t batchSize,
+                                        const BatchCallback &callback,
+                                        const std::atomic<bool> *cancel = nullptr);
+
 private:
     std::string delimiters_;
     bool firstRowHeader_;
+    bool useMemoryMapping_;
+    size_t numThreads_;
 };
 
 } // namespace
@@ -0,0 +1,221 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/csvscanner.h>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define IVW_CSV_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+// AVX2 enabled for the entire build
+#define IVW_CSV_AVX2
+#define IVW_CSV_AVX2_TARGET
+#include <immintrin.h>
+#elif defined(IVW_CSV_SSE2) && defined(__GNUC__)
+// compile the AVX2 path separately and select it at runtime
+#define IVW_CSV_AVX2
+#define IVW_CSV_AVX2_RUNTIME
+#define IVW_CSV_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * Computes the prefix XOR of all bits, i.e. bit i of the result is the XOR of bits 0 to i.
+ * Applied to the quote mask, all bits from an opening quote up to the closing quote are set.
+ */
+std::uint64_t prefixXor(std::uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+void computeMasksScalar(const char *block, const char *delimiters, size_t numDelimiters,
+                        std::uint64_t &quotes, std::uint64_t &newlines, std::uint64_t &delims) {
+    quotes = 0;
+    newlines = 0;
+    delims = 0;
+    for (size_t i = 0; i < CSVStructuralScanner::blockSize; ++i) {
+        const char ch = block[i];
+        const std::uint64_t bit = std::uint64_t{1} << i;
+        if (ch == '"') quotes |= bit;
+        if (ch == '\n') newlines |= bit;
+        for (size_t d = 0; d < numDelimiters; ++d) {
+            if (ch == delimiters[d]) delims |= bit;
+        }
+    }
+}
+
+#ifdef IVW_CSV_SSE2
+std::uint64_t cmpMaskSSE2(const __m128i (&data)[4], char ch) {
+    const __m128i c = _mm_set1_epi8(ch);
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        const auto bits = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(data[i], c)));
+        mask |= static_cast<std::uint64_t>(bits) << (16 * i);
+    }
+    return mask;
+}
+
+void computeMasksSSE2(const char *block, const char *delimiters, size_t numDelimiters,
+                      std::uint64_t &quotes, std::uint64_t &newlines, std::uint64_t &delims) {
+    const __m128i data[4] = {
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48))};
+    quotes = cmpMaskSSE2(data, '"');
+    newlines = cmpMaskSSE2(data, '\n');
+    delims = 0;
+    for (size_t d = 0; d < numDelimiters; ++d) {
+        delims |= cmpMaskSSE2(data, delimiters[d]);
+    }
+}
+#endif
+
+#ifdef IVW_CSV_AVX2
+IVW_CSV_AVX2_TARGET std::uint64_t cmpMaskAVX2(__m256i lo, __m256i hi, char ch) {
+    const __m256i c = _mm256_set1_epi8(ch);
+    const auto bitsLo = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, c)));
+    const auto bitsHi = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, c)));
+    return static_cast<std::uint64_t>(bitsLo) | (static_cast<std::uint64_t>(bitsHi) << 32);
+}
+
+IVW_CSV_AVX2_TARGET void computeMasksAVX2(const char *block, const char *delimiters,
+                                          size_t numDelimiters, std::uint64_t &quotes,
+                                          std::uint64_t &newlines, std::uint64_t &delims) {
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+    quotes = cmpMaskAVX2(lo, hi, '"');
+    newlines = cmpMaskAVX2(lo, hi, '\n');
+    delims = 0;
+    for (size_t d = 0; d < numDelimiters; ++d) {
+        delims |= cmpMaskAVX2(lo, hi, delimiters[d]);
+    }
+}
+#endif
+
+bool supportsAVX2() {
+#if defined(IVW_CSV_AVX2_RUNTIME)
+    return __builtin_cpu_supports("avx2") != 0;
+#elif defined(IVW_CSV_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool supportsSSE2() {
+#ifdef IVW_CSV_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+constexpr size_t CSVStructuralScanner::blockSize;
+
+CSVStructuralScanner::CSVStructuralScanner(const char *begin, const char *end,
+                                           const std::string &delimiters,
+                                           Implementation implementation)
+    : end_(end)
+    , block_(begin)
+    , mask_(0)
+    , inQuotes_(0)
+    , delimiters_(delimiters)
+    , implementation_(Implementation::Scalar)
+    , computeMasks_(&computeMasksScalar) {
+
+    if (implementation == Implementation::Auto) {
+        implementation = Implementation::AVX2;
+    }
+#ifdef IVW_CSV_AVX2
+    if ((implementation == Implementation::AVX2) && supportsAVX2()) {
+        implementation_ = Implementation::AVX2;
+        computeMasks_ = &computeMasksAVX2;
+    }
+#endif
+#ifdef IVW_CSV_SSE2
+    if ((implementation_ == Implementation::Scalar) &&
+        (implementation != Implementation::Scalar) && supportsSSE2()) {
+        implementation_ = Implementation::SSE2;
+        computeMasks_ = &computeMasksSSE2;
+    }
+#endif
+    scanBlock();
+}
+
+CSVStructuralScanner::Implementation CSVStructuralScanner::getImplementation() const {
+    return implementation_;
+}
+
+void CSVStructuralScanner::scanBlock() {
+    if (block_ >= end_) {
+        mask_ = 0;
+        return;
+    }
+    const size_t size = static_cast<size_t>(end_ - block_);
+
+    std::uint64_t quotes = 0;
+    std::uint64_t newlines = 0;
+    std::uint64_t delims = 0;
+    if (size >= blockSize) {
+        computeMasks_(block_, delimiters_.data(), delimiters_.size(), quotes, newlines, delims);
+    } else {
+        // pad the last block, bits beyond the end of the data are discarded
+        char padded[blockSize] = {};
+        std::memcpy(padded, block_, size);
+        computeMasks_(padded, delimiters_.data(), delimiters_.size(), quotes, newlines, delims);
+        const std::uint64_t valid = (std::uint64_t{1} << size) - 1;
+        quotes &= valid;
+        newlines &= valid;
+        delims &= valid;
+    }
+
+    const std::uint64_t inside = prefixXor(quotes) ^ inQuotes_;
+    // broadcast the state of the last byte to all bits
+    inQuotes_ = ~std::uint64_t{0} * (inside >> 63);
+    mask_ = quotes | newlines | (delims & ~inside);
+}
+
+}  // namespace inviwo
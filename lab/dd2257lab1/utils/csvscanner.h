@@ -0,0 +1,111 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_CSVSCANNER_H
+#define IVW_CSVSCANNER_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/bitops.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+/**
+ * \class CSVStructuralScanner
+ * \brief Locates structural characters of CSV data, i.e. quotes, line breaks, and delimiters,
+ * in blocks of 64 bytes.
+ *
+ * For each block, bitmasks of quotes, line breaks, and delimiters are computed using SSE2 or
+ * AVX2 if available, and a scalar loop otherwise. Quoted regions are resolved by a prefix-XOR
+ * over the quote mask, which allows to drop all delimiters enclosed in quotes. Quotes and
+ * line breaks are always reported, since the tokenizer relies on them for counting quotes and
+ * lines.
+ *
+ * The scanner must start at the beginning of a record, i.e. outside of quotes.
+ */
+class IVW_MODULE_DD2257LAB1_API CSVStructuralScanner {
+public:
+    enum class Implementation { Auto, Scalar, SSE2, AVX2 };
+
+    /**
+     * @param begin          start of the data, must not be within quotes
+     * @param end            end of the data
+     * @param delimiters     set of delimiter characters
+     * @param implementation instruction set used for computing the masks. Auto selects the
+     *                       best one supported by the CPU. Unsupported choices fall back to
+     *                       the next best one.
+     */
+    CSVStructuralScanner(const char *begin, const char *end, const std::string &delimiters,
+                         Implementation implementation = Implementation::Auto);
+
+    /**
+     * \brief returns the first structural character at or after \p pos, or end if there is
+     * none. Subsequent calls must not use a smaller \p pos.
+     */
+    const char *next(const char *pos) {
+        for (;;) {
+            if (block_ >= end_) return end_;
+            const size_t offset = (pos > block_) ? static_cast<size_t>(pos - block_) : 0u;
+            if (offset < blockSize) {
+                const std::uint64_t mask = mask_ & (~std::uint64_t{0} << offset);
+                if (mask != 0) {
+                    return block_ + util::countTrailingZeros(mask);
+                }
+            }
+            block_ = (static_cast<size_t>(end_ - block_) > blockSize) ? block_ + blockSize : end_;
+            scanBlock();
+        }
+    }
+
+    Implementation getImplementation() const;
+
+    static constexpr size_t blockSize = 64;
+
+    using MaskFunc = void (*)(const char *block, const char *delimiters, size_t numDelimiters,
+                              std::uint64_t &quotes, std::uint64_t &newlines,
+                              std::uint64_t &delims);
+
+private:
+    void scanBlock();
+
+    const char *end_;
+    const char *block_;
+    std::uint64_t mask_;
+    std::uint64_t inQuotes_;  //!< all bits set if the previous block ended inside quotes
+    std::string delimiters_;
+    Implementation implementation_;
+    MaskFunc computeMasks_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_CSVSCANNER_H
@@ -32,7 +32,12 @@
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 
-#include <dd2257lab1/utils/csvreader.h>
+#include <dd2257lab1/utils/dataframecache.h>
+#include <dd2257lab1/utils/filefingerprint.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <exception>
 
 namespace inviwo {
 
@@ -52,7 +57,11 @@ CSVSource::CSVSource()
     , firstRowIsHeaders_("firstRowIsHeaders", "First Row Contains Column Headers", true)
     , inputFile_("inputFile_", "CSV File")
     , delimiters_("delimiters", "Delimiters", ",")
-    , reloadData_("reloadData", "Reload Data") {
+    , reloadData_("reloadData", "Reload Data")
+    , useCache_("useCache", "Use Binary Cache", false)
+    , compressColumns_("compressColumns", "Compress Columns", false)
+    , progressiveLoading_("progressiveLoading", "Progressive Loading", false)
+    , batchSize_("batchSize", "First Batch Size", 100000, 1, 10000000) {
 
     addPort(data_);
 
@@ -60,17 +69,236 @@ CSVSource::CSVSource()
     addProperty(firstRowIsHeaders_);
     addProperty(delimiters_);
     addProperty(reloadData_);
+    addProperty(useCache_);
+    addProperty(compressColumns_);
+    addProperty(progressiveLoading_);
+    addProperty(batchSize_);
 
-    reloadData_.onChange([&] {});
+    reloadData_.onChange([&]() { forceReload_ = true; });
+    progressiveLoading_.onChange([&]() { batchSize_.setVisible(progressiveLoading_.get()); });
+    batchSize_.setVisible(progressiveLoading_.get());
 }
 
+CSVSource::~CSVSource() { stopLoading(); }
+
 void CSVSource::process() {
-    CSVReader reader;
+    DD2257_SCOPED_TIMER("CSVSource::process");
+    const auto key = getDataKey();
+    const auto fingerprint = getFileFingerprint(inputFile_.get());
+    const bool reload = forceReload_;
+    forceReload_ = false;
+
+    // a load for the current settings is still running, e.g. after Reload Data. The previous
+    // result must not replace it even though it matches the settings.
+    const bool loading = loadState_ && (loadKey_ == key) && (loadFingerprint_ == fingerprint);
+
+    if (!reload && !loading && dataFrame_ && (key == dataKey_) &&
+        (fingerprint == dataFingerprint_)) {
+        // neither the file nor the relevant settings have changed, reuse the previous result
+        stopLoading();
+        updateEncoding();
+        data_.setData(dataFrame_);
+        return;
+    }
+
+    if (!progressiveLoading_.get()) {
+        stopLoading();
+        setResult(loadDataFrame(fingerprint, reload), key, fingerprint);
+        return;
+    }
+
+    if (reload || !loadState_ || (loadKey_ != key) || (loadFingerprint_ != fingerprint)) {
+        // a valid cache is loaded right away, there is nothing to be gained from batches
+        if (auto dataFrame = (reload ? nullptr : readCache(fingerprint))) {
+            stopLoading();
+            setResult(dataFrame, key, fingerprint);
+            return;
+        }
+        // the previous data is kept until the first batch arrives
+        startLoading(fingerprint);
+        return;
+    }
+
+    std::shared_ptr<DataFrame> batch;
+    std::string error;
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(loadState_->mutex);
+        std::swap(batch, loadState_->batch);
+        error = loadState_->error;
+        done = loadState_->done;
+    }
+    if (!error.empty()) {
+        throw Exception(error);
+    }
+    if (done && batch) {
+        stopLoading();
+        setResult(batch, key, fingerprint);
+    } else if (batch) {
+        data_.setData(batch);
+    }
+}
+
+std::string CSVSource::getDataKey() const {
+    return inputFile_.get() + '\n' + delimiters_.get() + '\n' +
+           (firstRowIsHeaders_.get() ? "1" : "0");
+}
+
+void CSVSource::setResult(std::shared_ptr<DataFrame> dataFrame, const std::string &key,
+                          const FileFingerprint &fingerprint) {
+    // the new result has not been published yet and can be encoded in place
+    if (compressColumns_.get()) {
+        dataFrame->compress();
+    } else {
+        dataFrame->decompress();
+    }
+    dataFrame_ = dataFrame;
+    dataCompressed_ = compressColumns_.get();
+    dataKey_ = key;
+    dataFingerprint_ = fingerprint;
+    DD2257_COUNTER("CSVSource::rows", dataFrame->getNumberOfRows());
+    DD2257_GAUGE("CSVSource::dataFrameBytes", dataFrame->getMemoryUsage());
+    data_.setData(dataFrame);
+}
+
+void CSVSource::updateEncoding() {
+    if (!dataFrame_ || (dataCompressed_ == compressColumns_.get())) return;
+    // the published result might still be used downstream, encode a copy instead. The copy
+    // shares the column buffers, only the encoded or decoded values are new.
+    auto dataFrame = std::make_shared<DataFrame>(*dataFrame_);
+    if (compressColumns_.get()) {
+        dataFrame->compress();
+    } else {
+        dataFrame->decompress();
+    }
+    dataFrame_ = dataFrame;
+    dataCompressed_ = compressColumns_.get();
+}
 
+CSVReader CSVSource::createReader() const {
+    CSVReader reader;
     reader.setDelimiters(delimiters_.get());
     reader.setFirstRowHeader(firstRowIsHeaders_.get());
+    return reader;
+}
+
+std::shared_ptr<DataFrame> CSVSource::loadDataFrame(const FileFingerprint &fingerprint,
+                                                    bool ignoreCache) {
+    if (!useCache_.get()) {
+        return createReader().readData(inputFile_.get());
+    }
+    if (!ignoreCache) {
+        if (auto dataFrame = readCache(fingerprint)) {
+            return dataFrame;
+        }
+    }
+    auto dataFrame = createReader().readData(inputFile_.get());
+    try {
+        writeDataFrameCache(*dataFrame, getDataFrameCacheFileName(inputFile_.get()),
+                            getSourceChecksum(fingerprint));
+    } catch (Exception &e) {
+        LogWarn("Could not write cache: " << e.getMessage());
+    }
+    return dataFrame;
+}
+
+std::shared_ptr<DataFrame> CSVSource::readCache(const FileFingerprint &fingerprint) const {
+    if (!useCache_.get()) {
+        return nullptr;
+    }
+    try {
+        return readDataFrameCache(getDataFrameCacheFileName(inputFile_.get()),
+                                  getSourceChecksum(fingerprint));
+    } catch (Exception &e) {
+        LogWarn("Could not read cache: " << e.getMessage());
+        return nullptr;
+    }
+}
+
+std::uint64_t CSVSource::getSourceChecksum(const FileFingerprint &fingerprint) const {
+    const std::string settings =
+        delimiters_.get() + '\n' + (firstRowIsHeaders_.get() ? "1" : "0");
+    return util::hashBytes(settings.data(), settings.data() + settings.size(),
+                           fingerprint.getChecksum());
+}
+
+void CSVSource::startLoading(const FileFingerprint &fingerprint) {
+    stopLoading();
+
+    auto state = std::make_shared<LoadState>();
+    loadState_ = state;
+    loadKey_ = getDataKey();
+    loadFingerprint_ = fingerprint;
+
+    auto reader = createReader();
+
+    // batches are handed over to the main thread, which invalidates the processor unless it
+    // has been deleted or started another load in the meantime
+    std::weak_ptr<LoadState> weakState = state;
+    auto notify = [this, weakState]() {
+        InviwoApplication::getPtr()->dispatchFront([this, weakState]() {
+            auto current = weakState.lock();
+            if (current && (current == loadState_)) {
+                invalidate(InvalidationLevel::InvalidOutput);
+            }
+        });
+    };
+
+    const auto fileName = inputFile_.get();
+    const size_t batchSize = batchSize_.get();
+    const bool useCache = useCache_.get();
+    const std::uint64_t checksum = getSourceChecksum(fingerprint);
+    loader_ = std::thread([state, reader, fileName, batchSize, useCache, checksum,
+                           notify]() mutable {
+        try {
+            auto dataFrame = reader.readData(fileName, batchSize,
+                                             [&](std::shared_ptr<DataFrame> batch) {
+                                                 {
+                                                     std::lock_guard<std::mutex> lock(
+                                                         state->mutex);
+                                                     state->batch = batch;
+                                                 }
+                                                 notify();
+                                             },
+                                             &state->cancel);
+            if (dataFrame) {
+                if (useCache) {
+                    try {
+                        writeDataFrameCache(*dataFrame, getDataFrameCacheFileName(fileName),
+                                            checksum);
+                    } catch (std::exception &) {
+                        // the cache is optional, the data is used regardless
+                    }
+                }
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->batch = dataFrame;
+                state->done = true;
+            }
+        } catch (Exception &e) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->error = e.getMessage();
+        } catch (std::exception &e) {
+            // e.g. std::bad_alloc, nothing may escape the thread
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->error = "Failed to load \"" + fileName + "\": " + e.what();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->error = "Failed to load \"" + fileName + "\"";
+        }
+        if (!state->cancel.load()) {
+            notify();
+        }
+    });
+}
 
-    data_.setData(reader.readData(inputFile_.get()));
+void CSVSource::stopLoading() {
+    if (loadState_) {
+        loadState_->cancel = true;
+    }
+    if (loader_.joinable()) {
+        loader_.join();
+    }
+    loadState_.reset();
 }
 
 }  // namespace inviwo
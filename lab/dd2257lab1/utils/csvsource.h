@@ -40,6 +40,15 @@
 #include <inviwo/core/ports/dataoutport.h>
 #include <inviwo/core/properties/stringproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+#include <dd2257lab1/utils/csvreader.h>
+#include <dd2257lab1/utils/filefingerprint.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
 
 namespace inviwo {
 
@@ -53,12 +62,25 @@ namespace inviwo {
  * ### Properties
  *   * __First Row Headers__   if true, the first row is used as column names in the DataFrame
  *   * __Delimiters__          defines the delimiter between values (default ',')
+ *   * __Reload Data__         reads the input file again, bypassing the binary cache.
+ *                             Otherwise, the file is only read if it or one of the
+ *                             settings above has changed.
+ *   * __Use Binary Cache__    if true, the parsed data is stored in a binary file next to the
+ *                             input file (file name + ".dfcache"), which is used instead of
+ *                             parsing the input again as long as the input file and the
+ *                             settings are unchanged. Off by default since it requires write
+ *                             access to the directory of the input file.
+ *   * __Compress Columns__    if true, the columns of the loaded data are encoded to reduce
+ *                             memory, e.g. run-length or bit-packed. \see ColumnEncoding
+ *   * __Progressive Loading__ if true, the file is parsed in the background and the rows read
+ *                             so far are emitted, first after __First Batch Size__ rows and
+ *                             then each time the number of rows has doubled
  */
 
 class IVW_MODULE_DD2257LAB1_API CSVSource : public Processor {
 public:
     CSVSource();
-    virtual ~CSVSource() = default;
+    virtual ~CSVSource();
 
     virtual void process() override;
 
@@ -66,11 +88,74 @@ public:
     static const ProcessorInfo processorInfo_;
 
 private:
+    /**
+     * State shared between the processor and a background loader. Batches are handed over
+     * to the processor, which emits them in process().
+     */
+    struct LoadState {
+        std::mutex mutex;
+        std::shared_ptr<DataFrame> batch;
+        std::string error;
+        bool done = false;  ///< true if batch holds the complete data
+        std::atomic<bool> cancel{false};
+    };
+
+    void startLoading(const FileFingerprint &fingerprint);
+    void stopLoading();
+    /**
+     * Identifies the input file and all settings affecting the parsed result
+     */
+    std::string getDataKey() const;
+    /**
+     * Emits the complete data of the input file, which is kept for reuse as long as neither
+     * the file nor the settings change.
+     */
+    void setResult(std::shared_ptr<DataFrame> dataFrame, const std::string &key,
+                   const FileFingerprint &fingerprint);
+    /**
+     * \brief replaces the complete result with a copy whose columns are encoded or decoded as
+     * requested, if the setting has changed. The emitted DataFrame is never modified.
+     */
+    void updateEncoding();
+
+    CSVReader createReader() const;
+    /**
+     * Reads the input file, using the binary cache if enabled and valid. The cache is
+     * rebuilt whenever the input file has been parsed.
+     */
+    std::shared_ptr<DataFrame> loadDataFrame(const FileFingerprint &fingerprint,
+                                             bool ignoreCache);
+    /**
+     * Returns the cached DataFrame if the cache is enabled and matches the input file and
+     * the current settings, nullptr otherwise.
+     */
+    std::shared_ptr<DataFrame> readCache(const FileFingerprint &fingerprint) const;
+    /**
+     * Checksum of the input file given by \p fingerprint combined with the settings
+     */
+    std::uint64_t getSourceChecksum(const FileFingerprint &fingerprint) const;
+
     DataOutport<DataFrame> data_;
     BoolProperty firstRowIsHeaders_;
     FileProperty inputFile_;
     StringProperty delimiters_;
     ButtonProperty reloadData_;
+    BoolProperty useCache_;
+    BoolProperty compressColumns_;
+    BoolProperty progressiveLoading_;
+    IntSizeTProperty batchSize_;
+
+    // complete result of the last load
+    std::shared_ptr<DataFrame> dataFrame_;
+    std::string dataKey_;
+    FileFingerprint dataFingerprint_;
+    bool dataCompressed_ = false;  ///< state of Compress Columns applied to dataFrame_
+    bool forceReload_ = false;
+
+    std::shared_ptr<LoadState> loadState_;
+    std::string loadKey_;
+    FileFingerprint loadFingerprint_;
+    std::thread loader_;
 };
 
 }  // namespace inviwo
@@ -31,8 +31,17 @@
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <dd2257lab1/utils/dataframe.h>
 #include <dd2257lab1/utils/datapoint.h>
+#include <dd2257lab1/utils/parallel.h>
 #include <inviwo/core/util/formatdispatching.h>
 
+#include <dd2257lab1/utils/numberparser.h>
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <sstream>
+
 namespace inviwo {
 
 /*
@@ -74,6 +83,8 @@ std::shared_ptr<CategoricalColumn> DataFrame::addCategoricalColumn(const std::st
     return col;
 }
 
+void DataFrame::addColumn(std::shared_ptr<Column> column) { columns_.push_back(column); }
+
 void DataFrame::addRow(const std::vector<std::string> &data) {
     if (columns_.size() <= 1) {
         throw NoColumns("DataFrame: DataFrame has no columns");
@@ -82,15 +93,81 @@ void DataFrame::addRow(const std::vector<std::string> &data) {
     }
     // try to match up input data with columns.
     for (size_t i = 0; i < data.size(); ++i) {
-        try {
-            columns_[i+1]->add(data[i]);
-        } catch (InvalidConversion &) {
+        addValue(i + 1, data[i].data(), data[i].data() + data[i].size());
+    }
+}
+
+void DataFrame::addRow(const std::vector<FieldView> &data) {
+    if (columns_.size() <= 1) {
+        throw NoColumns("DataFrame: DataFrame has no columns");
+    } else if (columns_.size() != data.size() + 1) { // consider index column of DataFrame
+        throw InvalidColCount("DataFrame: data does not match column count");
+    }
+    for (size_t i = 0; i < data.size(); ++i) {
+        addValue(i + 1, data[i].first, data[i].second);
+    }
+}
+
+void DataFrame::addRows(const std::vector<FieldView> &data) {
+    if (columns_.size() <= 1) {
+        throw NoColumns("DataFrame: DataFrame has no columns");
+    }
+    const size_t stride = columns_.size() - 1;  // consider index column of DataFrame
+    if (data.size() % stride != 0) {
+        throw InvalidColCount("DataFrame: data does not match column count");
+    }
+    const size_t rows = data.size() / stride;
+    for (size_t col = 1; col < columns_.size(); ++col) {
+        const FieldView *fields = data.data() + (col - 1);
+        size_t added = 0;
+        while (added < rows) {
+            added += columns_[col]->add(fields + added * stride, rows - added, stride);
+            if (added < rows) {
+                // value does not fit the column type, widen the column and continue
+                const auto &field = fields[added * stride];
+                addValue(col, field.first, field.second);
+                ++added;
+            }
+        }
+    }
+}
+
+void DataFrame::reserve(size_t rows) {
+    for (auto &column : columns_) {
+        column->reserve(rows);
+    }
+}
+
+void DataFrame::addValue(size_t index, const char *first, const char *last) {
+    try {
+        columns_[index]->add(first, last);
+    } catch (InvalidConversion &) {
+        // widen the column such that it can hold the value
+        const auto current = getColumnType(*columns_[index]);
+        const auto type = widenColumnType(current, detectColumnType(first, last));
+        if (type == current) {
             throw DataTypeMismatch("DataFrame: data type does not match (col. " +
-                                   std::to_string(i + 1) + ")");
+                                   std::to_string(index) + ")");
         }
+        widenColumn(index, type);
+        columns_[index]->add(first, last);
     }
 }
 
+void DataFrame::widenColumn(size_t index, ColumnType type) {
+    const auto current = getColumnType(*columns_[index]);
+    const auto widened = widenColumnType(current, type);
+    if (widened != current) {
+        columns_[index] = convertColumn(*columns_[index], widened);
+    }
+}
+
+std::shared_ptr<Column> DataFrame::releaseColumn(size_t index) {
+    auto column = createColumn(getColumnType(*columns_[index]), columns_[index]->getHeader());
+    std::swap(column, columns_[index]);
+    return column;
+}
+
 DataFrame::DataItem DataFrame::getDataItem(size_t index, bool getStringsAsStrings) const {
     DataItem di;
     for (auto column : columns_) {
@@ -125,6 +202,28 @@ size_t DataFrame::getSize() const {
 
 size_t DataFrame::getNumberOfColumns() const { return columns_.size(); }
 
+void DataFrame::compress() {
+    util::forEachRangeParallel(columns_.size(), [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            columns_[i]->compress();
+        }
+    });
+}
+
+void DataFrame::decompress() {
+    for (auto &column : columns_) {
+        column->setEncoding(ColumnEncoding::Plain);
+    }
+}
+
+size_t DataFrame::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto &column : columns_) {
+        bytes += column->getMemoryUsage();
+    }
+    return bytes;
+}
+
 size_t DataFrame::getNumberOfRows() const { return getSize(); }
 
 DataFrame::DataFrame(const DataFrame &df) {
@@ -133,14 +232,12 @@ DataFrame::DataFrame(const DataFrame &df) {
     }
 }
 
-std::vector<std::shared_ptr<Column>>::const_iterator DataFrame::end() const {
-    return columns_.end();
-}
+DataFrame::ConstIterator DataFrame::end() const { return ConstIterator(columns_.end()); }
 
 const std::vector<std::pair<std::string, const DataFormatBase *>> DataFrame::getHeaders() const {
     std::vector<std::pair<std::string, const DataFormatBase *>> headers;
     for (const auto &c : columns_) {
-        headers.emplace_back(c->getHeader(), c->getBuffer()->getDataFormat());
+        headers.emplace_back(c->getHeader(), c->getDataFormat());
     }
     return headers;
 }
@@ -161,9 +258,7 @@ std::shared_ptr<TemplateColumn<std::uint32_t>> DataFrame::getIndexColumn() {
 
 std::vector<std::shared_ptr<Column>>::iterator DataFrame::begin() { return columns_.begin(); }
 
-std::vector<std::shared_ptr<Column>>::const_iterator DataFrame::begin() const {
-    return columns_.begin();
-}
+DataFrame::ConstIterator DataFrame::begin() const { return ConstIterator(columns_.begin()); }
 
 std::vector<std::shared_ptr<Column>>::iterator DataFrame::end() { return columns_.end(); }
 
@@ -174,21 +269,175 @@ std::shared_ptr<DataFrame> createDataFrame(const std::vector<std::string> &examp
         throw InvalidColCount("Number of headers does not match column count");
     }
 
+    std::vector<ColumnType> types;
+    for (const auto &value : exampleData) {
+        types.push_back(detectColumnType(value.data(), value.data() + value.size()));
+    }
+    return createDataFrame(types, colHeaders);
+}
+
+std::shared_ptr<DataFrame> createDataFrame(const std::vector<ColumnType> &types,
+                                           const std::vector<std::string> &colHeaders) {
+    if (!colHeaders.empty() && (colHeaders.size() != types.size())) {
+        throw InvalidColCount("Number of headers does not match column count");
+    }
+
     auto dataFrame = std::make_shared<DataFrame>(0u);
-    for (size_t i = 0; i < exampleData.size(); ++i) {
+    for (size_t i = 0; i < types.size(); ++i) {
         const auto header =
             (!colHeaders.empty() ? colHeaders[i] : std::string("Column ") + std::to_string(i + 1));
+        dataFrame->addColumn(createColumn(types[i], header));
+    }
+    return dataFrame;
+}
 
-        std::istringstream iss(exampleData[i]);
+ColumnType detectColumnType(const char *first, const char *last) {
+    if (util::isBlank(first, last)) {
+        return ColumnType::Float;
+    }
+    std::int64_t intValue;
+    if (util::parseInteger(first, last, intValue)) {
+        const bool fitsInt32 =
+            (intValue >= std::numeric_limits<std::int32_t>::lowest()) &&
+            (intValue <= std::numeric_limits<std::int32_t>::max());
+        return fitsInt32 ? ColumnType::Int32 : ColumnType::Int64;
+    }
+    double value;
+    size_t significantDigits;
+    if (util::parseDouble(first, last, value, &significantDigits)) {
+        const double absValue = std::abs(value);
+        const bool fitsFloat =
+            (significantDigits <= static_cast<size_t>(std::numeric_limits<float>::digits10)) &&
+            (!std::isfinite(value) || (absValue == 0.0) ||
+             ((absValue >= std::numeric_limits<float>::min()) &&
+              (absValue <= std::numeric_limits<float>::max())));
+        return fitsFloat ? ColumnType::Float : ColumnType::Double;
+    }
+    return ColumnType::Categorical;
+}
+
+ColumnType widenColumnType(ColumnType a, ColumnType b) {
+    const bool isInteger = (a == ColumnType::Int32) || (a == ColumnType::Int64) ||
+                           (b == ColumnType::Int32) || (b == ColumnType::Int64);
+    if (isInteger && ((a == ColumnType::Float) || (b == ColumnType::Float))) {
+        // float cannot represent integers above 2^24, e.g. IDs of a column with blank cells
+        return ColumnType::Double;
+    }
+    return std::max(a, b);
+}
 
-        float d;
-        if (iss >> d) {  // ordinal buffer
-            dataFrame->addColumn<float>(header, 0u);
-        } else {  // nominal buffer
-            dataFrame->addCategoricalColumn(header, 0);
+ColumnType getColumnType(const Column &column) {
+    if (dynamic_cast<const CategoricalColumn *>(&column)) {
+        return ColumnType::Categorical;
+    }
+    const auto format = column.getDataFormat();
+    switch (format->getNumericType()) {
+        case NumericType::Float:
+            return (format->getSize() > 4) ? ColumnType::Double : ColumnType::Float;
+        case NumericType::SignedInteger:
+            return (format->getSize() > 4) ? ColumnType::Int64 : ColumnType::Int32;
+        case NumericType::UnsignedInteger:
+            // unsigned 32 bit values do not fit into int32
+            return (format->getSize() >= 4) ? ColumnType::Int64 : ColumnType::Int32;
+        default:
+            return ColumnType::Categorical;
+    }
+}
+
+std::shared_ptr<Column> createColumn(ColumnType type, const std::string &header) {
+    switch (type) {
+        case ColumnType::Int32:
+            return std::make_shared<TemplateColumn<std::int32_t>>(header);
+        case ColumnType::Int64:
+            return std::make_shared<TemplateColumn<std::int64_t>>(header);
+        case ColumnType::Float:
+            return std::make_shared<TemplateColumn<float>>(header);
+        case ColumnType::Double:
+            return std::make_shared<TemplateColumn<double>>(header);
+        case ColumnType::Categorical:
+        default:
+            return std::make_shared<CategoricalColumn>(header);
+    }
+}
+
+namespace {
+
+template <typename T>
+std::shared_ptr<Column> convertValues(const Column &column) {
+    auto result = std::make_shared<TemplateColumn<T>>(column.getHeader());
+    auto &values = result->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+    values.reserve(column.getSize());
+    for (size_t i = 0; i < column.getSize(); ++i) {
+        values.push_back(static_cast<T>(column.getAsDouble(i)));
+    }
+    return result;
+}
+
+template <typename T>
+std::string formatValue(T value, std::true_type /*integral*/) {
+    return std::to_string(value);
+}
+
+/**
+ * Uses the shortest precision that parses back to the same value. Blank cells are stored as
+ * NaN and become empty strings again.
+ */
+template <typename T>
+std::string formatValue(T value, std::false_type /*integral*/) {
+    if (std::isnan(value)) return {};
+    std::ostringstream stream;
+    stream.imbue(std::locale::classic());
+    for (int precision = std::numeric_limits<T>::digits10;; ++precision) {
+        stream.str({});
+        stream << std::setprecision(precision) << value;
+        const auto str = stream.str();
+        T parsed;
+        if ((precision >= std::numeric_limits<T>::max_digits10) ||
+            (util::parseNumber(str.data(), str.data() + str.size(), parsed) &&
+             (parsed == value))) {
+            return str;
         }
     }
-    return dataFrame;
+}
+
+/**
+ * Converts the values of a numeric column into categories. The original text of the values is
+ * not available anymore, the text is chosen such that it converts back to the same value.
+ * \see CSVReader, which avoids this conversion by parsing categorical columns as such.
+ */
+std::shared_ptr<Column> convertToCategorical(const Column &column) {
+    if (getColumnType(column) == ColumnType::Categorical) {
+        return std::shared_ptr<Column>(column.clone());
+    }
+    auto result = std::make_shared<CategoricalColumn>(column.getHeader());
+    result->reserve(column.getSize());
+    column.getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
+        [&](auto buf) {
+            using BufferType = std::remove_cv_t<decltype(buf)>;
+            using ValueType = util::PrecsionValueType<BufferType>;
+            for (auto value : buf->getDataContainer()) {
+                result->add(formatValue(value, std::is_integral<ValueType>{}));
+            }
+        });
+    return result;
+}
+
+}  // namespace
+
+std::shared_ptr<Column> convertColumn(const Column &column, ColumnType type) {
+    switch (type) {
+        case ColumnType::Int32:
+            return convertValues<std::int32_t>(column);
+        case ColumnType::Int64:
+            return convertValues<std::int64_t>(column);
+        case ColumnType::Float:
+            return convertValues<float>(column);
+        case ColumnType::Double:
+            return convertValues<double>(column);
+        case ColumnType::Categorical:
+        default:
+            return convertToCategorical(column);
+    }
 }
 
 }  // namespace inviwo
@@ -39,6 +39,7 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
 #include <inviwo/core/util/exception.h>
+#include <iterator>
 #include <unordered_map>
 
 namespace inviwo {
@@ -67,11 +68,21 @@ public:
     virtual ~DataTypeMismatch() throw() {}
 };
 
+/**
+ * \brief data types of columns created from textual data, ordered from narrowest to widest
+ */
+enum class ColumnType { Int32, Int64, Float, Double, Categorical };
+
 class IVW_MODULE_DD2257LAB1_API DataFrame {
 public:
     using DataItem = std::vector<std::shared_ptr<DataPointBase>>;
     using LookupTable = std::unordered_map<glm::u64, std::string>;
+    using FieldView = Column::FieldView;
 
+    /**
+     * \brief creates a copy of \p df. The column data is shared with \p df and only copied
+     * when either column is modified, i.e. the copy costs O(number of columns).
+     */
     DataFrame(const DataFrame &df);
 
     DataFrame(std::uint32_t size = 0);
@@ -85,17 +96,77 @@ public:
 
     std::shared_ptr<CategoricalColumn> addCategoricalColumn(const std::string &header,
                                                             size_t size = 0);
+
+    void addColumn(std::shared_ptr<Column> column);
+
     /**
-     * \brief add a new row given a vector of strings
+     * \brief add a new row given a vector of strings. If a value cannot be represented by the
+     * data type of its column, the column is widened first, \see widenColumn.
      *
      * @param data  data for each column
      * @throws NoColumns        if the data frame has no columns defined
      * @throws InvalidColCount  if column count of DataFrame does not match the number of columns in
      * data
      * @throws DataTypeMismatch  if the data type of a column doesn't match with the input data
+     * and the column cannot be widened
      */
     void addRow(const std::vector<std::string> &data);
+    /**
+     * \brief add a new row given a vector of character ranges, the values are converted
+     * directly into the column buffers without creating intermediate strings.
+     *
+     * \see addRow(const std::vector<std::string> &)
+     */
+    void addRow(const std::vector<FieldView> &data);
+    /**
+     * \brief add several rows at once given as consecutive character ranges, i.e. the
+     * first row is data[0] ... data[n-1], the second one data[n] ... data[2n-1] and so on where
+     * n is the number of data columns. The values are converted column by column.
+     *
+     * \see addRow(const std::vector<std::string> &)
+     * @throws InvalidColCount  if the size of data is not a multiple of the column count
+     */
+    void addRows(const std::vector<FieldView> &data);
 
+    /**
+     * \brief reserves memory for a total of \p rows rows in each column
+     */
+    void reserve(size_t rows);
+
+    /**
+     * \brief converts the column at \p index such that it can hold values of \p type, i.e.
+     * the column type becomes widenColumnType(current type, type). Existing values are
+     * converted, the column object is replaced in the process.
+     */
+    void widenColumn(size_t index, ColumnType type);
+    /**
+     * \brief replaces the column at \p index with an empty column of the same type and header
+     * and returns the previous one. Allows to hand over the values of a column without keeping
+     * a second copy alive, e.g. when stitching DataFrames.
+     */
+    std::shared_ptr<Column> releaseColumn(size_t index);
+
+    /**
+     * \brief encodes all columns to reduce their memory footprint, \see Column::compress().
+     * The columns are processed in parallel.
+     */
+    void compress();
+    /**
+     * \brief reverts all columns to plain storage
+     */
+    void decompress();
+    /**
+     * \brief returns the number of bytes used by the values of all columns
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * \brief returns all values of the given row, each one wrapped in a DataPoint
+     *
+     * \deprecated allocates one DataPoint per value. Use RowView, i.e. RowAccessor or
+     * forEachRow (rowview.h), which reads the values directly from the column buffers.
+     */
+    [[deprecated("use RowView (RowAccessor, forEachRow) instead")]]
     DataItem getDataItem(size_t index, bool getStringsAsStrings = false) const;
 
     const std::vector<std::pair<std::string, const DataFormatBase *>> getHeaders() const;
@@ -111,14 +182,50 @@ public:
     size_t getNumberOfColumns() const;
     size_t getNumberOfRows() const;
 
+    /**
+     * \brief iterates over the columns of a const DataFrame, yielding
+     * std::shared_ptr<const Column>. Only the const interface of the columns is reachable, which
+     * does not detach shared buffers or drop the encoding and statistics of a column.
+     */
+    class ConstIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::shared_ptr<const Column>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = value_type;
+
+        ConstIterator() = default;
+        explicit ConstIterator(std::vector<std::shared_ptr<Column>>::const_iterator it)
+            : it_(it) {}
+
+        value_type operator*() const { return *it_; }
+        ConstIterator &operator++() {
+            ++it_;
+            return *this;
+        }
+        ConstIterator operator++(int) {
+            auto it = *this;
+            ++it_;
+            return it;
+        }
+        bool operator==(const ConstIterator &rhs) const { return it_ == rhs.it_; }
+        bool operator!=(const ConstIterator &rhs) const { return it_ != rhs.it_; }
+
+    private:
+        std::vector<std::shared_ptr<Column>>::const_iterator it_;
+    };
+
     std::vector<std::shared_ptr<Column>>::iterator begin();
     std::vector<std::shared_ptr<Column>>::iterator end();
-    std::vector<std::shared_ptr<Column>>::const_iterator begin() const;
-    std::vector<std::shared_ptr<Column>>::const_iterator end() const;
+    ConstIterator begin() const;
+    ConstIterator end() const;
 
     void updateIndexBuffer();
 
 private:
+    void addValue(size_t index, const char *first, const char *last);
+
     std::vector<std::shared_ptr<Column>> columns_;
 };
 
@@ -135,6 +242,44 @@ using DataFrameInport = DataInport<DataFrame>;
 std::shared_ptr<DataFrame> IVW_MODULE_DD2257LAB1_API createDataFrame(
     const std::vector<std::string> &exampleData, const std::vector<std::string> &colHeaders = {});
 
+/**
+ * \brief create a new, empty DataFrame with columns of the given types
+ *
+ * @param types        data type of each column
+ * @param colHeaders   headers for the columns. If none given, "Column 1", "Column 2", ... is used
+ * @throws InvalidColCount  if column count between types and colHeaders does not match
+ */
+std::shared_ptr<DataFrame> IVW_MODULE_DD2257LAB1_API createDataFrame(
+    const std::vector<ColumnType> &types, const std::vector<std::string> &colHeaders = {});
+
+/**
+ * \brief returns the narrowest column type able to represent the value [first, last). Empty
+ * values are considered missing, which requires a floating point type (NaN).
+ */
+IVW_MODULE_DD2257LAB1_API ColumnType detectColumnType(const char *first, const char *last);
+
+/**
+ * \brief returns the narrowest column type able to represent values of both \p a and \p b,
+ * i.e. the order int32 -> int64 -> float -> double -> categorical. Integers combined with float
+ * yield double, which represents all int32 values and thus also integer columns with empty
+ * values.
+ */
+IVW_MODULE_DD2257LAB1_API ColumnType widenColumnType(ColumnType a, ColumnType b);
+
+IVW_MODULE_DD2257LAB1_API ColumnType getColumnType(const Column &column);
+
+IVW_MODULE_DD2257LAB1_API std::shared_ptr<Column> createColumn(ColumnType type,
+                                                               const std::string &header);
+
+/**
+ * \brief creates a copy of \p column with the given type. Values are converted via double.
+ * Categories are formatted from the numeric values such that they convert back to the same
+ * value, the original text (e.g. leading zeros) cannot be recovered. Blank values (NaN) become
+ * empty categories.
+ */
+IVW_MODULE_DD2257LAB1_API std::shared_ptr<Column> convertColumn(const Column &column,
+                                                                ColumnType type);
+
 template <typename T>
 std::shared_ptr<TemplateColumn<T>> DataFrame::addColumn(const std::string &header, size_t size) {
     auto col = std::make_shared<TemplateColumn<T>>(header);
@@ -155,14 +300,20 @@ struct port_traits<DataFrame> {
         doc.append("b", "DataFrame", {{"style", "color:white;"}});
         utildoc::TableBuilder tb(doc.handle(), P::end());
         tb(H("Number of columns: "), data->getNumberOfColumns());
+        tb(H("Memory (bytes): "), data->getMemoryUsage());
 
         for (size_t i = 0; i < data->getNumberOfColumns(); i++) {
             std::ostringstream oss;
             oss << "Column " << (i + 1) << ": " << data->getHeader(i);
             tb(H(oss.str()), "");
 
-            tb("size", data->getColumn(i)->getBuffer()->getSize());
-            tb("Dataformat", data->getColumn(i)->getBuffer()->getDataFormat()->getString());
+            tb("size", data->getColumn(i)->getSize());
+            tb("Dataformat", data->getColumn(i)->getDataFormat()->getString());
+            tb("Encoding", getEncodingName(data->getColumn(i)->getEncoding()));
+            if (auto cat = dynamic_cast<const CategoricalColumn *>(data->getColumn(i).get())) {
+                tb("Categories", cat->getCardinality());
+                tb("Dictionary bytes", cat->getDictionary().getMemoryUsage());
+            }
         }
 
         return doc;
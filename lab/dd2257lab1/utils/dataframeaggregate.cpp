@@ -0,0 +1,155 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/dataframeaggregate.h>
+#include <dd2257lab1/utils/aggregation.h>
+#include <dd2257lab1/utils/instrumentation.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+/// splits a comma separated list and trims surrounding whitespace, empty entries are skipped
+std::vector<std::string> splitList(const std::string &str) {
+    std::vector<std::string> result;
+    std::istringstream iss(str);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        const auto first = item.find_first_not_of(" \t");
+        if (first == std::string::npos) continue;
+        const auto last = item.find_last_not_of(" \t");
+        result.push_back(item.substr(first, last - first + 1));
+    }
+    return result;
+}
+
+size_t findColumn(const DataFrame &dataFrame, const std::string &header) {
+    // skip the index column
+    for (size_t i = 1; i < dataFrame.getNumberOfColumns(); ++i) {
+        if (dataFrame.getHeader(i) == header) {
+            return i;
+        }
+    }
+    throw Exception("DataFrameAggregate: no column \"" + header + "\"");
+}
+
+}  // namespace
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameAggregate::processorInfo_{
+    "org.inviwo.DataFrameAggregate",            // Class identifier
+    "DataFrame Aggregate",                      // Display name
+    "DD2257",                                   // Category
+    CodeState::Experimental,                    // Code state
+    "CPU, DataFrame, Group By, Sort",           // Tags
+};
+const ProcessorInfo DataFrameAggregate::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameAggregate::DataFrameAggregate()
+    : Processor()
+    , inport_("dataFrame")
+    , outport_("result")
+    , groupBy_("groupBy", "Group By")
+    , aggregates_("aggregates", "Aggregates")
+    , count_("count", "Count", true)
+    , sum_("sum", "Sum", false)
+    , mean_("mean", "Mean", true)
+    , min_("min", "Min", false)
+    , max_("max", "Max", false)
+    , variance_("variance", "Variance", false)
+    , sortBy_("sortBy", "Sort By") {
+
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperty(groupBy_);
+    aggregates_.addProperty(count_);
+    aggregates_.addProperty(sum_);
+    aggregates_.addProperty(mean_);
+    aggregates_.addProperty(min_);
+    aggregates_.addProperty(max_);
+    aggregates_.addProperty(variance_);
+    addProperty(aggregates_);
+    addProperty(sortBy_);
+}
+
+void DataFrameAggregate::process() {
+    DD2257_SCOPED_TIMER("DataFrameAggregate::process");
+    auto result = inport_.getData();
+
+    const auto keyHeaders = splitList(groupBy_.get());
+    if (!keyHeaders.empty()) {
+        std::vector<size_t> keys;
+        for (const auto &header : keyHeaders) {
+            keys.push_back(findColumn(*result, header));
+        }
+
+        std::vector<AggregateFunction> functions;
+        const std::vector<std::pair<const BoolProperty *, AggregateFunction>> options = {
+            {&count_, AggregateFunction::Count}, {&sum_, AggregateFunction::Sum},
+            {&mean_, AggregateFunction::Mean},   {&min_, AggregateFunction::Min},
+            {&max_, AggregateFunction::Max},     {&variance_, AggregateFunction::Variance}};
+        for (const auto &option : options) {
+            if (option.first->get()) functions.push_back(option.second);
+        }
+
+        std::vector<Aggregation> aggregations;
+        for (size_t col = 1; col < result->getNumberOfColumns(); ++col) {
+            if (std::find(keys.begin(), keys.end(), col) != keys.end()) continue;
+            // sum, mean, etc. of category IDs are meaningless, only count categories
+            const bool categorical =
+                dynamic_cast<const CategoricalColumn *>(result->getColumn(col).get()) != nullptr;
+            for (auto func : functions) {
+                if (!categorical || (func == AggregateFunction::Count)) {
+                    aggregations.push_back({col, func});
+                }
+            }
+        }
+        result = groupBy(*result, keys, aggregations);
+    }
+
+    const auto sortHeaders = splitList(sortBy_.get());
+    if (!sortHeaders.empty()) {
+        std::vector<SortKey> keys;
+        for (const auto &header : sortHeaders) {
+            SortKey key;
+            key.ascending = header.front() != '-';
+            key.column = findColumn(*result, key.ascending ? header : header.substr(1));
+            keys.push_back(key);
+        }
+        result = gatherRows(*result, sortRows(*result, keys));
+    }
+
+    outport_.setData(result);
+}
+
+}  // namespace inviwo
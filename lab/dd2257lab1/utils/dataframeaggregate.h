@@ -0,0 +1,91 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DATAFRAMEAGGREGATE_H
+#define IVW_DATAFRAMEAGGREGATE_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+
+#include <dd2257lab1/utils/dataframe.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/stringproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.DataFrameAggregate, DataFrame Aggregate}
+ * ![](org.inviwo.DataFrameAggregate.png?classIdentifier=org.inviwo.DataFrameAggregate)
+ * Groups the rows of a DataFrame by one or more key columns and summarizes each group, e.g.
+ * one row per dataset of datasaurusDozen.csv. The result can be sorted.
+ *
+ * ### Inports
+ *   * __dataFrame__  input data
+ *
+ * ### Outports
+ *   * __result__  one row per group holding the keys and the selected aggregates of all
+ *                 other columns, or the sorted input if no key columns are given
+ *
+ * ### Properties
+ *   * __Group By__    comma separated headers of the key columns
+ *   * __Aggregates__  functions computed for each non-key column, the result columns are
+ *                     named "function(header)", e.g. "mean(x)". Categorical columns
+ *                     are only counted.
+ *   * __Sort By__     comma separated headers of the result columns to sort by, a leading
+ *                     '-' sorts in descending order, e.g. "dataset, -mean(x)"
+ */
+class IVW_MODULE_DD2257LAB1_API DataFrameAggregate : public Processor {
+public:
+    DataFrameAggregate();
+    virtual ~DataFrameAggregate() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataInport<DataFrame> inport_;
+    DataOutport<DataFrame> outport_;
+
+    StringProperty groupBy_;
+    CompositeProperty aggregates_;
+    BoolProperty count_;
+    BoolProperty sum_;
+    BoolProperty mean_;
+    BoolProperty min_;
+    BoolProperty max_;
+    BoolProperty variance_;
+    StringProperty sortBy_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_DATAFRAMEAGGREGATE_H
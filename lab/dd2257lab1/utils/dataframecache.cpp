@@ -0,0 +1,333 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/dataframecache.h>
+#include <dd2257lab1/utils/memorymappedfile.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace inviwo {
+
+namespace {
+
+constexpr char magic[8] = {'I', 'V', 'W', 'D', 'F', 'C', 'H', 'E'};
+constexpr std::uint32_t formatVersion = 1;
+constexpr std::uint32_t byteOrderMarker = 0x01020304;
+constexpr std::uint64_t blockAlignment = 64;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t checksum;
+    std::uint64_t fileSize;
+    std::uint64_t rows;
+    std::uint64_t columns;
+};
+
+/// location of a block within the file, in bytes
+struct Block {
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+struct ColumnEntry {
+    std::uint32_t type;
+    std::uint32_t reserved;
+    Block header;
+    Block data;
+    Block dictOffsets;  // only used by categorical columns
+    Block dictChars;
+};
+
+std::uint64_t align(std::uint64_t offset) {
+    return (offset + blockAlignment - 1) / blockAlignment * blockAlignment;
+}
+
+template <typename T>
+const std::vector<T> &getValues(const Column &column) {
+    auto typed = dynamic_cast<const TemplateColumn<T> *>(&column);
+    if (!typed) {
+        throw Exception("DataFrame cache: unsupported data format of column \"" +
+                        column.getHeader() + "\"");
+    }
+    return typed->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+}
+
+/// raw bytes of the data block of a column
+std::pair<const char *, std::uint64_t> getDataBlock(const Column &column, ColumnType type) {
+    auto bytes = [](const auto &values) {
+        return std::make_pair(reinterpret_cast<const char *>(values.data()),
+                              static_cast<std::uint64_t>(values.size() * sizeof(values[0])));
+    };
+    switch (type) {
+        case ColumnType::Int32:
+            return bytes(getValues<std::int32_t>(column));
+        case ColumnType::Int64:
+            return bytes(getValues<std::int64_t>(column));
+        case ColumnType::Float:
+            return bytes(getValues<float>(column));
+        case ColumnType::Double:
+            return bytes(getValues<double>(column));
+        case ColumnType::Categorical:
+        default:
+            return bytes(getValues<std::uint32_t>(column));
+    }
+}
+
+bool isValid(const Block &block, std::uint64_t fileSize) {
+    return (block.offset <= fileSize) && (block.size <= fileSize - block.offset) &&
+           (block.offset % blockAlignment == 0);
+}
+
+template <typename T>
+std::shared_ptr<Column> readValues(std::shared_ptr<Column> column, const char *data,
+                                   std::uint64_t rows) {
+    auto typed = std::static_pointer_cast<TemplateColumn<T>>(column);
+    const T *values = reinterpret_cast<const T *>(data);
+    typed->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer().assign(
+        values, values + rows);
+    return column;
+}
+
+std::uint64_t getValueSize(ColumnType type) {
+    switch (type) {
+        case ColumnType::Int64:
+        case ColumnType::Double:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+/**
+ * Restores a single column, returns nullptr if the entry is inconsistent
+ */
+std::shared_ptr<Column> readColumn(const ColumnEntry &entry, const MemoryMappedFile &file,
+                                   std::uint64_t rows) {
+    const auto fileSize = static_cast<std::uint64_t>(file.size());
+    if ((entry.type > static_cast<std::uint32_t>(ColumnType::Categorical)) ||
+        !isValid(entry.header, fileSize) || !isValid(entry.data, fileSize)) {
+        return nullptr;
+    }
+    const auto type = static_cast<ColumnType>(entry.type);
+    if (entry.data.size != rows * getValueSize(type)) {
+        return nullptr;
+    }
+
+    const char *base = file.data();
+    auto column = createColumn(
+        type, std::string(base + entry.header.offset, static_cast<size_t>(entry.header.size)));
+    const char *data = base + entry.data.offset;
+    switch (type) {
+        case ColumnType::Int32:
+            return readValues<std::int32_t>(column, data, rows);
+        case ColumnType::Int64:
+            return readValues<std::int64_t>(column, data, rows);
+        case ColumnType::Float:
+            return readValues<float>(column, data, rows);
+        case ColumnType::Double:
+            return readValues<double>(column, data, rows);
+        case ColumnType::Categorical:
+        default:
+            break;
+    }
+
+    // categorical column, check the dictionary before handing it over
+    if (!isValid(entry.dictOffsets, fileSize) || !isValid(entry.dictChars, fileSize) ||
+        (entry.dictOffsets.size % sizeof(std::uint64_t) != 0) ||
+        (entry.dictOffsets.size == 0)) {
+        return nullptr;
+    }
+    const auto offsets = reinterpret_cast<const std::uint64_t *>(base + entry.dictOffsets.offset);
+    const size_t count = static_cast<size_t>(entry.dictOffsets.size / sizeof(std::uint64_t)) - 1;
+    if ((offsets[0] != 0) || (offsets[count] != entry.dictChars.size) ||
+        !std::is_sorted(offsets, offsets + count + 1)) {
+        return nullptr;
+    }
+    const auto ids = reinterpret_cast<const std::uint32_t *>(data);
+    if ((rows > 0) && (*std::max_element(ids, ids + rows) >= count)) {
+        return nullptr;
+    }
+    StringDictionary dictionary;
+    dictionary.assign(base + entry.dictChars.offset, offsets, count);
+
+    auto categorical = std::static_pointer_cast<CategoricalColumn>(column);
+    categorical->setDictionary(std::move(dictionary));
+    return readValues<std::uint32_t>(column, data, rows);
+}
+
+}  // namespace
+
+std::string getDataFrameCacheFileName(const std::string &sourceFile) {
+    return sourceFile + ".dfcache";
+}
+
+void writeDataFrameCache(const DataFrame &dataFrame, const std::string &fileName,
+                         std::uint64_t sourceChecksum) {
+    const size_t columnCount = dataFrame.getNumberOfColumns() - 1;  // skip index column
+    const std::uint64_t rows = dataFrame.getNumberOfRows();
+
+    FileHeader header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = formatVersion;
+    header.byteOrder = byteOrderMarker;
+    header.checksum = sourceChecksum;
+    header.rows = rows;
+    header.columns = columnCount;
+
+    // determine the layout of all blocks
+    struct BlockData {
+        std::uint64_t offset;
+        const char *data;
+        std::uint64_t size;
+    };
+    std::vector<ColumnEntry> entries(columnCount);
+    std::vector<BlockData> blocks;
+    std::uint64_t offset = align(sizeof(FileHeader) + columnCount * sizeof(ColumnEntry));
+    auto addBlock = [&](const char *data, std::uint64_t size) {
+        blocks.push_back({offset, data, size});
+        Block block{offset, size};
+        offset = align(offset + size);
+        return block;
+    };
+    for (size_t i = 0; i < columnCount; ++i) {
+        auto column = dataFrame.getColumn(i + 1);
+        if (column->getSize() != rows) {
+            throw Exception("DataFrame cache: column \"" + column->getHeader() +
+                            "\" does not match the number of rows");
+        }
+        auto &entry = entries[i];
+        const auto type = getColumnType(*column);
+        entry.type = static_cast<std::uint32_t>(type);
+        entry.reserved = 0;
+        entry.header = addBlock(column->getHeader().data(), column->getHeader().size());
+        const auto data = getDataBlock(*column, type);
+        entry.data = addBlock(data.first, data.second);
+        entry.dictOffsets = Block{0, 0};
+        entry.dictChars = Block{0, 0};
+        if (auto categorical = dynamic_cast<const CategoricalColumn *>(column.get())) {
+            const auto &dict = categorical->getDictionary();
+            entry.dictOffsets =
+                addBlock(reinterpret_cast<const char *>(dict.getOffsets().data()),
+                         dict.getOffsets().size() * sizeof(std::uint64_t));
+            entry.dictChars = addBlock(dict.getCharacters().data(), dict.getCharacters().size());
+        }
+    }
+    header.fileSize = offset;
+
+    const std::string tmpFileName = fileName + ".tmp";
+    {
+        std::ofstream file(tmpFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw FileException("DataFrame cache: Could not open file \"" + tmpFileName +
+                                "\" for writing.");
+        }
+        const char padding[blockAlignment] = {};
+        std::uint64_t pos = 0;
+        auto write = [&](const char *data, std::uint64_t size) {
+            file.write(data, static_cast<std::streamsize>(size));
+            pos += size;
+        };
+        auto pad = [&](std::uint64_t target) { write(padding, target - pos); };
+
+        write(reinterpret_cast<const char *>(&header), sizeof(header));
+        write(reinterpret_cast<const char *>(entries.data()),
+              entries.size() * sizeof(ColumnEntry));
+        for (auto &block : blocks) {
+            pad(block.offset);
+            write(block.data, block.size);
+        }
+        pad(header.fileSize);
+
+        if (!file.good()) {
+            file.close();
+            std::remove(tmpFileName.c_str());
+            throw FileException("DataFrame cache: Could not write file \"" + tmpFileName +
+                                "\".");
+        }
+    }
+    // rename does not replace existing files on all platforms
+    std::remove(fileName.c_str());
+    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+        std::remove(tmpFileName.c_str());
+        throw FileException("DataFrame cache: Could not write file \"" + fileName + "\".");
+    }
+}
+
+std::shared_ptr<DataFrame> readDataFrameCache(const std::string &fileName,
+                                              std::uint64_t sourceChecksum) {
+    if (!filesystem::fileExists(fileName)) {
+        return nullptr;
+    }
+    MemoryMappedFile file(fileName);
+    const auto fileSize = static_cast<std::uint64_t>(file.size());
+
+    FileHeader header;
+    if (fileSize < sizeof(header)) {
+        return nullptr;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if ((std::memcmp(header.magic, magic, sizeof(magic)) != 0) ||
+        (header.version != formatVersion) || (header.byteOrder != byteOrderMarker) ||
+        (header.checksum != sourceChecksum) || (header.fileSize != fileSize) ||
+        (header.rows > fileSize) ||
+        (header.columns > (fileSize - sizeof(header)) / sizeof(ColumnEntry))) {
+        return nullptr;
+    }
+    const size_t columnCount = static_cast<size_t>(header.columns);
+    std::vector<ColumnEntry> entries(columnCount);
+    std::memcpy(entries.data(), file.data() + sizeof(header), columnCount * sizeof(ColumnEntry));
+
+    // columns are independent of each other
+    std::vector<std::shared_ptr<Column>> columns(columnCount);
+    util::forEachRangeParallel(columnCount, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            columns[i] = readColumn(entries[i], file, header.rows);
+        }
+    });
+
+    auto dataFrame = std::make_shared<DataFrame>(0u);
+    for (auto &column : columns) {
+        if (!column) {
+            return nullptr;
+        }
+        dataFrame->addColumn(column);
+    }
+    dataFrame->updateIndexBuffer();
+    return dataFrame;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,88 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DATAFRAMECACHE_H
+#define IVW_DATAFRAMECACHE_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/dataframe.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+/**
+ * Binary columnar file format for DataFrames, used for caching parsed CSV files.
+ *
+ * All values are stored in native byte order and every block starts at a multiple of 64
+ * bytes. The file consists of
+ *   - a header with magic number, format version, byte order marker, checksum of the source,
+ *     and the number of rows and columns,
+ *   - one entry per column holding its type as well as the location of its header string,
+ *     its data block, and for categorical columns the dictionary blocks (string offsets and
+ *     characters, \see StringDictionary),
+ *   - the blocks themselves.
+ * The index column is not stored, it is recreated on load.
+ */
+
+/**
+ * \brief returns the name of the cache file belonging to \p sourceFile, which is located
+ * next to it
+ */
+IVW_MODULE_DD2257LAB1_API std::string getDataFrameCacheFileName(const std::string &sourceFile);
+
+/**
+ * \brief writes \p dataFrame to \p fileName. The file is written to a temporary file first
+ * and then renamed, i.e. readers never see a partially written file.
+ *
+ * @param sourceChecksum   identifies the source of the data, \see readDataFrameCache
+ * @throws FileException if the file cannot be written
+ * @throws Exception     if a column type cannot be represented in the file format
+ */
+IVW_MODULE_DD2257LAB1_API void writeDataFrameCache(const DataFrame &dataFrame,
+                                                   const std::string &fileName,
+                                                   std::uint64_t sourceChecksum);
+
+/**
+ * \brief reads a DataFrame written by writeDataFrameCache. The file is memory mapped and the
+ * column blocks are copied into the column buffers as a whole, in parallel for all columns.
+ *
+ * @param sourceChecksum   expected checksum of the source
+ * @return nullptr if the file does not exist, was written for a different source checksum,
+ *         format version, or byte order, or is inconsistent
+ * @throws FileException if the file exists but cannot be mapped
+ */
+IVW_MODULE_DD2257LAB1_API std::shared_ptr<DataFrame> readDataFrameCache(
+    const std::string &fileName, std::uint64_t sourceChecksum);
+
+}  // namespace inviwo
+
+#endif  // IVW_DATAFRAMECACHE_H
@@ -0,0 +1,195 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/dataframefilter.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/numberparser.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameFilter::processorInfo_{
+    "org.inviwo.DataFrameFilter",             // Class identifier
+    "DataFrame Filter",                       // Display name
+    "DD2257",                                 // Category
+    CodeState::Experimental,                  // Code state
+    "CPU, Plotting, DataFrame, Selection",    // Tags
+};
+const ProcessorInfo DataFrameFilter::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameFilter::DataFrameFilter()
+    : Processor()
+    , inport_("dataFrame")
+    , selectionInport_("inputSelection")
+    , outport_("selection")
+    , column_("column", "Column")
+    , predicate_("predicate", "Predicate",
+                 {{"range", "Range", static_cast<int>(Predicate::Range)},
+                  {"equal", "Equal", static_cast<int>(Predicate::Equal)},
+                  {"in", "In", static_cast<int>(Predicate::In)}})
+    , range_("range", "Range", 0.0, 1.0, 0.0, 1.0)
+    , values_("values", "Values")
+    , invert_("invert", "Invert", false)
+    , combine_("combine", "Combine",
+               {{"and", "And", static_cast<int>(Combine::And)},
+                {"or", "Or", static_cast<int>(Combine::Or)}}) {
+
+    addPort(inport_);
+    addPort(selectionInport_);
+    selectionInport_.setOptional(true);
+    addPort(outport_);
+
+    addProperty(column_);
+    addProperty(predicate_);
+    addProperty(range_);
+    addProperty(values_);
+    addProperty(invert_);
+    addProperty(combine_);
+
+    inport_.onChange([&]() { updateColumns(); });
+    column_.onChange([&]() { updateRange(true); });
+
+    auto updateVisibility = [&]() {
+        const bool range = static_cast<Predicate>(predicate_.get()) == Predicate::Range;
+        range_.setVisible(range);
+        values_.setVisible(!range);
+    };
+    predicate_.onChange(updateVisibility);
+    updateVisibility();
+}
+
+void DataFrameFilter::updateColumns() {
+    if (!inport_.hasData()) return;
+
+    const auto selected = column_.size() > 0 ? column_.getSelectedIndex() : 0;
+    const auto headers = inport_.getData()->getHeaders();
+
+    column_.clearOptions();
+    // skip the index column
+    for (size_t i = 1; i < headers.size(); ++i) {
+        column_.addOption(headers[i].first, headers[i].first, static_cast<int>(i));
+    }
+    if (column_.size() > 0) {
+        column_.setSelectedIndex(std::min(selected, column_.size() - 1));
+    }
+    updateRange(false);
+}
+
+void DataFrameFilter::updateRange(bool resetValue) {
+    if (!inport_.hasData() || column_.size() == 0) return;
+
+    const auto dataFrame = inport_.getData();
+    const auto col = static_cast<size_t>(column_.get());
+    if (col >= dataFrame->getNumberOfColumns()) return;
+
+    const auto stats = dataFrame->getColumn(col)->getStatistics();
+    if (stats->size == stats->nanCount) return;
+
+    const dvec2 bounds(stats->min, stats->max);
+    range_.setRange(bounds);
+    if (resetValue) {
+        range_.set(bounds);
+    }
+}
+
+std::vector<std::string> DataFrameFilter::getValues() const {
+    std::vector<std::string> values;
+    std::istringstream iss(values_.get());
+    std::string value;
+    while (std::getline(iss, value, ',')) {
+        // trim surrounding whitespace
+        const auto first = value.find_first_not_of(" \t");
+        const auto last = value.find_last_not_of(" \t");
+        values.push_back(first == std::string::npos ? ""
+                                                    : value.substr(first, last - first + 1));
+    }
+    return values;
+}
+
+void DataFrameFilter::process() {
+    DD2257_SCOPED_TIMER("DataFrameFilter::process");
+    const auto dataFrame = inport_.getData();
+    const auto col = static_cast<size_t>(column_.get());
+    if (col == 0 || col >= dataFrame->getNumberOfColumns()) {
+        throw Exception("DataFrameFilter: invalid column " + std::to_string(col));
+    }
+    const auto column = dataFrame->getColumn(col);
+    const bool categorical = dynamic_cast<const CategoricalColumn *>(column.get()) != nullptr;
+
+    Selection selection;
+    switch (static_cast<Predicate>(predicate_.get())) {
+        case Predicate::Range:
+            selection = selectRange(*column, range_.get().x, range_.get().y);
+            break;
+        case Predicate::Equal:
+        case Predicate::In: {
+            auto values = getValues();
+            if (static_cast<Predicate>(predicate_.get()) == Predicate::Equal) {
+                values.resize(std::min<size_t>(values.size(), 1));
+            }
+            if (categorical) {
+                selection = selectIn(*column, values);
+            } else {
+                std::vector<double> numbers;
+                for (const auto &value : values) {
+                    // locale-independent, the entire value has to be a number
+                    double number;
+                    if (!util::parseDouble(value.data(), value.data() + value.size(), number)) {
+                        throw Exception("DataFrameFilter: \"" + value + "\" is not a number");
+                    }
+                    numbers.push_back(number);
+                }
+                selection = selectIn(*column, std::move(numbers));
+            }
+            break;
+        }
+    }
+    if (invert_.get()) {
+        selection.invert();
+        // NaN values are never selected, neither by the predicate nor by its inversion
+        if (!categorical && (column->getStatistics()->nanCount > 0)) {
+            selection &= selectValid(*column);
+        }
+    }
+
+    if (selectionInport_.hasData()) {
+        if (static_cast<Combine>(combine_.get()) == Combine::And) {
+            selection &= *selectionInport_.getData();
+        } else {
+            selection |= *selectionInport_.getData();
+        }
+    }
+
+    outport_.setData(std::make_shared<Selection>(std::move(selection)));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,103 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DATAFRAMEFILTER_H
+#define IVW_DATAFRAMEFILTER_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+
+#include <dd2257lab1/utils/dataframe.h>
+#include <dd2257lab1/utils/selection.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/minmaxproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/stringproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.DataFrameFilter, DataFrame Filter}
+ * ![](org.inviwo.DataFrameFilter.png?classIdentifier=org.inviwo.DataFrameFilter)
+ * Selects the rows of a DataFrame matching a predicate on one of its columns. Filters can be
+ * chained through the optional input selection to combine several predicates.
+ *
+ * ### Inports
+ *   * __dataFrame__       input data
+ *   * __inputSelection__  optional selection, which is combined with the result
+ *
+ * ### Outports
+ *   * __selection__  selected rows, e.g. for the Scatter Plot or Parallel Coordinates
+ *
+ * ### Properties
+ *   * __Column__     column the predicate is evaluated on
+ *   * __Predicate__  Range: min <= value <= max, Equal: value equals the first entry of
+ *                    __Values__, In: value equals any entry of __Values__
+ *   * __Range__      value range for the Range predicate
+ *   * __Values__     comma separated numbers or, for categorical columns, categories
+ *   * __Invert__     selects all rows not matching the predicate, except for NaN values
+ *   * __Combine__    logical operation used to combine the result with the input selection
+ */
+class IVW_MODULE_DD2257LAB1_API DataFrameFilter : public Processor {
+public:
+    DataFrameFilter();
+    virtual ~DataFrameFilter() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    enum class Predicate { Range, Equal, In };
+    enum class Combine { And, Or };
+
+    void updateColumns();
+    /**
+     * \brief adjusts the bounds of the range property to the values of the current column.
+     * If \p resetValue is true, the whole value range is selected.
+     */
+    void updateRange(bool resetValue);
+    std::vector<std::string> getValues() const;
+
+    DataInport<DataFrame> inport_;
+    SelectionInport selectionInport_;
+    SelectionOutport outport_;
+
+    OptionPropertyInt column_;
+    OptionPropertyInt predicate_;
+    DoubleMinMaxProperty range_;
+    StringProperty values_;
+    BoolProperty invert_;
+    OptionPropertyInt combine_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_DATAFRAMEFILTER_H
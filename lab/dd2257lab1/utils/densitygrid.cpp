@@ -0,0 +1,167 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/densitygrid.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+// number of rows fetched from the columns at once
+constexpr size_t batchSize = 4096;
+// rows per task, binning fewer rows in parallel does not pay off the per-thread grids
+constexpr size_t minRowsPerTask = size_t{1} << 16;
+// upper bound for the memory of all per-thread grids together
+constexpr size_t maxTaskGridBytes = size_t{64} << 20;
+
+// maps v to a bin in [0, count), or count if v lies outside [min, max] or is NaN
+inline size_t toBin(double v, double min, double scale, size_t count) {
+    const double pos = (v - min) * scale;
+    if (!(pos >= 0.0) || pos > static_cast<double>(count)) return count;
+    return std::min(static_cast<size_t>(pos), count - 1);
+}
+
+/**
+ * Bins the rows into one grid per task and sums the grids into grid.bins. Counts use 32 bit
+ * bins, weights double bins. The number of tasks is limited such that each task bins at least
+ * as many rows as there are bins and that the grids fit into maxTaskGridBytes.
+ */
+template <typename Bin>
+void binRows(const Column &x, const Column &y, const Column *weights,
+             const std::vector<std::uint32_t> *rows, double scaleX, double scaleY,
+             DensityGrid &grid) {
+    const auto dims = grid.dims;
+    const auto rangeX = grid.rangeX;
+    const auto rangeY = grid.rangeY;
+    const size_t binCount = dims.x * dims.y;
+    const size_t rowCount = rows ? rows->size() : x.getSize();
+    const size_t maxTasks = std::max<size_t>(
+        1u, std::min({util::getHardwareThreadCount(), rowCount / binCount,
+                      maxTaskGridBytes / (binCount * sizeof(Bin))}));
+    std::vector<std::vector<Bin>> taskGrids(maxTasks);
+
+    const size_t tasks = util::forEachRangeParallel(
+        rowCount,
+        [&](size_t begin, size_t end, size_t task) {
+            auto &bins = taskGrids[task];
+            bins.assign(binCount, Bin(0));
+            std::vector<double> bufX(batchSize), bufY(batchSize), bufW(weights ? batchSize : 0);
+            for (size_t first = begin; first < end; first += batchSize) {
+                const size_t count = std::min(batchSize, end - first);
+                if (rows) {
+                    const auto indices = rows->data() + first;
+                    x.gatherValuesAsDouble(indices, count, bufX.data());
+                    y.gatherValuesAsDouble(indices, count, bufY.data());
+                    if (weights) weights->gatherValuesAsDouble(indices, count, bufW.data());
+                } else {
+                    x.getValuesAsDouble(first, first + count, bufX.data());
+                    y.getValuesAsDouble(first, first + count, bufY.data());
+                    if (weights) weights->getValuesAsDouble(first, first + count, bufW.data());
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    const size_t bx = toBin(bufX[i], rangeX.x, scaleX, dims.x);
+                    const size_t by = toBin(bufY[i], rangeY.x, scaleY, dims.y);
+                    if (bx == dims.x || by == dims.y) continue;
+                    const double w = weights ? bufW[i] : 1.0;
+                    if (std::isnan(w)) continue;
+                    bins[by * dims.x + bx] += static_cast<Bin>(w);
+                }
+            }
+        },
+        minRowsPerTask, maxTasks);
+
+    // sum the per-task grids, each task reducing a range of bins
+    grid.bins.assign(binCount, 0.0);
+    if (tasks == 0) return;
+    std::vector<double> taskMax(util::getHardwareThreadCount(), 0.0);
+    util::forEachRangeParallel(
+        binCount,
+        [&](size_t begin, size_t end, size_t task) {
+            double maxMagnitude = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                double sum = 0.0;
+                for (size_t t = 0; t < tasks; ++t) {
+                    sum += static_cast<double>(taskGrids[t][i]);
+                }
+                grid.bins[i] = sum;
+                maxMagnitude = std::max(maxMagnitude, std::abs(sum));
+            }
+            taskMax[task] = maxMagnitude;
+        },
+        minRowsPerTask / 4, taskMax.size());
+    grid.maxMagnitude = *std::max_element(taskMax.begin(), taskMax.end());
+}
+
+}  // namespace
+
+double DensityGrid::getLogScaled(size_t idx) const {
+    if (maxMagnitude <= 0.0) return 0.0;
+    return std::log1p(std::abs(bins[idx])) / std::log1p(maxMagnitude);
+}
+
+DensityGrid computeDensityGrid(const Column &x, const Column &y, const Column *weights,
+                               dvec2 rangeX, dvec2 rangeY, size2_t dims,
+                               const std::vector<std::uint32_t> *rows) {
+    DD2257_SCOPED_TIMER("computeDensityGrid");
+    if (x.getSize() != y.getSize() || (weights && weights->getSize() != x.getSize())) {
+        throw Exception("Columns of the density grid differ in size");
+    }
+    if (dims.x == 0 || dims.y == 0) {
+        throw Exception("Density grid requires at least one bin");
+    }
+
+    DensityGrid grid;
+    grid.dims = dims;
+    grid.rangeX = rangeX;
+    grid.rangeY = rangeY;
+
+    // a degenerate range puts all values into the first bin
+    const auto scale = [](dvec2 range, size_t count) {
+        const double extent = range.y - range.x;
+        return extent > 0.0 ? static_cast<double>(count) / extent : 0.0;
+    };
+    const double scaleX = scale(rangeX, dims.x);
+    const double scaleY = scale(rangeY, dims.y);
+
+    // counts of fewer than 2^32 rows fit into 32 bit bins, which halves the per-thread grids
+    if (!weights && (x.getSize() <= std::numeric_limits<std::uint32_t>::max())) {
+        binRows<std::uint32_t>(x, y, weights, rows, scaleX, scaleY, grid);
+    } else {
+        binRows<double>(x, y, weights, rows, scaleX, scaleY, grid);
+    }
+    return grid;
+}
+
+}  // namespace inviwo
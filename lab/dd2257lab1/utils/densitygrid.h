@@ -0,0 +1,82 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DENSITYGRID_H
+#define IVW_DENSITYGRID_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/column.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+/**
+ * \brief regular 2D grid of bins covering a rectangular value range, e.g. a 2D histogram of
+ * two columns. Bins are stored row by row, i.e. bin (x, y) is at index y * dims.x + x.
+ */
+struct IVW_MODULE_DD2257LAB1_API DensityGrid {
+    size2_t dims{0};
+    dvec2 rangeX{0.0};
+    dvec2 rangeY{0.0};
+    std::vector<double> bins;
+    double maxMagnitude = 0.0;  ///< largest absolute bin value
+
+    double get(size_t x, size_t y) const { return bins[y * dims.x + x]; }
+
+    /**
+     * \brief log-scaled magnitude of bin \p idx in [0, 1], i.e. log(1 + |v|) / log(1 + max).
+     * Unlike a linear scale this keeps sparse bins visible next to very dense ones.
+     */
+    double getLogScaled(size_t idx) const;
+};
+
+/**
+ * \brief bins the points (x[i], y[i]) into a grid of \p dims bins covering \p rangeX times
+ * \p rangeY. Each bin holds the number of points within it or, if \p weights is given, the sum
+ * of their weights. Points outside the ranges or with NaN coordinates are ignored, values on
+ * the upper bound of a range fall into the last bin.
+ *
+ * The columns are read in small batches, each thread bins into its own grid and the grids are
+ * summed at the end. Memory use thus depends on the number of bins, not on the number of rows:
+ * counts use 32 bit grids, and fewer threads are used for large grids such that all grids
+ * together stay below 64 MiB besides the result.
+ *
+ * @param rows  optional subset of the rows to bin, all rows are binned if null
+ * @throws Exception if the columns differ in size or dims is zero
+ */
+IVW_MODULE_DD2257LAB1_API DensityGrid computeDensityGrid(
+    const Column &x, const Column &y, const Column *weights, dvec2 rangeX, dvec2 rangeY,
+    size2_t dims, const std::vector<std::uint32_t> *rows = nullptr);
+
+}  // namespace inviwo
+
+#endif  // IVW_DENSITYGRID_H
@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/filefingerprint.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace inviwo {
+
+namespace {
+
+// number of bytes hashed at the beginning and the end of a file
+constexpr std::uint64_t hashedBlockSize = 64u * 1024u;
+
+std::uint64_t hashValue(std::uint64_t value, std::uint64_t seed) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    return util::hashBytes(bytes, bytes + sizeof(value), seed);
+}
+
+}  // namespace
+
+std::uint64_t FileFingerprint::getChecksum() const {
+    auto h = hashValue(size, contentHash);
+    return hashValue(static_cast<std::uint64_t>(modificationTime), h);
+}
+
+bool FileFingerprint::operator==(const FileFingerprint &rhs) const {
+    return (size == rhs.size) && (modificationTime == rhs.modificationTime) &&
+           (contentHash == rhs.contentHash);
+}
+
+bool FileFingerprint::operator!=(const FileFingerprint &rhs) const { return !(*this == rhs); }
+
+FileFingerprint getFileFingerprint(const std::string &fileName) {
+    FileFingerprint fingerprint;
+#ifdef WIN32
+    struct _stat64 status;
+    if (_stat64(fileName.c_str(), &status) != 0) {
+        throw FileException("Could not access file \"" + fileName + "\".");
+    }
+    fingerprint.modificationTime = static_cast<std::int64_t>(status.st_mtime) * 1000000000;
+#else
+    struct stat status;
+    if (stat(fileName.c_str(), &status) != 0) {
+        throw FileException("Could not access file \"" + fileName + "\".");
+    }
+#if defined(__APPLE__)
+    fingerprint.modificationTime =
+        static_cast<std::int64_t>(status.st_mtimespec.tv_sec) * 1000000000 +
+        status.st_mtimespec.tv_nsec;
+#else
+    fingerprint.modificationTime =
+        static_cast<std::int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#endif
+#endif
+    fingerprint.size = static_cast<std::uint64_t>(status.st_size);
+
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException("Could not open file \"" + fileName + "\".");
+    }
+    std::vector<char> block(static_cast<size_t>(std::min(fingerprint.size, hashedBlockSize)));
+    file.read(block.data(), block.size());
+    auto h = util::hashBytes(block.data(), block.data() + file.gcount());
+    if (fingerprint.size > hashedBlockSize) {
+        const auto tail = std::min(fingerprint.size - hashedBlockSize, hashedBlockSize);
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(fingerprint.size - tail), std::ios::beg);
+        file.read(block.data(), static_cast<std::streamsize>(tail));
+        h = util::hashBytes(block.data(), block.data() + file.gcount(), h);
+    }
+    fingerprint.contentHash = h;
+    return fingerprint;
+}
+
+namespace util {
+
+std::uint64_t hashBytes(const char *first, const char *last, std::uint64_t seed) {
+    std::uint64_t h = seed;
+    for (; first != last; ++first) {
+        h ^= static_cast<unsigned char>(*first);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,80 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_FILEFINGERPRINT_H
+#define IVW_FILEFINGERPRINT_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+/**
+ * \struct FileFingerprint
+ * \brief Cheap identification of the state of a file given by its size, modification time,
+ * and a hash over the first and last block of its content. The content hash catches
+ * modifications which preserve both size and time stamp, e.g. a copied file, while keeping
+ * the cost independent of the file size.
+ */
+struct IVW_MODULE_DD2257LAB1_API FileFingerprint {
+    std::uint64_t size = 0;
+    std::int64_t modificationTime = 0;  ///< nanoseconds since epoch where available
+    std::uint64_t contentHash = 0;
+
+    /**
+     * \brief combines all members into a single value
+     */
+    std::uint64_t getChecksum() const;
+
+    bool operator==(const FileFingerprint &rhs) const;
+    bool operator!=(const FileFingerprint &rhs) const;
+};
+
+/**
+ * \brief determines the fingerprint of the given file
+ *
+ * @throws FileException if the file cannot be accessed
+ */
+IVW_MODULE_DD2257LAB1_API FileFingerprint getFileFingerprint(const std::string &fileName);
+
+namespace util {
+
+/**
+ * \brief FNV-1a hash of the byte range [first, last) continuing from \p seed
+ */
+IVW_MODULE_DD2257LAB1_API std::uint64_t hashBytes(const char *first, const char *last,
+                                                  std::uint64_t seed = 14695981039346656037ull);
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_FILEFINGERPRINT_H
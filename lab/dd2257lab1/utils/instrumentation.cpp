@@ -0,0 +1,395 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/instrumentation.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace instrumentation {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// bounds the memory used for the trace, summaries keep counting beyond it
+constexpr size_t maxEventsPerThread = size_t{1} << 20;
+constexpr size_t maxRetiredEvents = size_t{1} << 22;
+
+std::atomic<bool> enabled{false};
+const Clock::time_point epoch = Clock::now();
+
+std::int64_t toNs(Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch).count();
+}
+
+struct TimerStat {
+    size_t calls = 0;
+    double totalMs = 0.0;
+    double minMs = std::numeric_limits<double>::infinity();
+    double maxMs = 0.0;
+
+    void add(double ms) {
+        ++calls;
+        totalMs += ms;
+        minMs = std::min(minMs, ms);
+        maxMs = std::max(maxMs, ms);
+    }
+    void merge(const TimerStat &rhs) {
+        calls += rhs.calls;
+        totalMs += rhs.totalMs;
+        minMs = std::min(minMs, rhs.minMs);
+        maxMs = std::max(maxMs, rhs.maxMs);
+    }
+};
+
+struct IntervalEvent {
+    const char *name;
+    std::int64_t startNs;
+    std::int64_t durationNs;
+    std::uint32_t tid;
+};
+
+struct GaugeEvent {
+    const char *name;
+    std::int64_t timeNs;
+    std::int64_t value;
+};
+
+// Recorded data of one thread. Only the owning thread writes to it, the mutex is uncontended
+// unless the data is read or reset at the same time.
+struct ThreadData {
+    std::mutex mutex;
+    std::uint32_t tid = 0;
+    std::vector<IntervalEvent> events;
+    std::unordered_map<const char *, TimerStat> timers;
+    std::unordered_map<const char *, std::int64_t> counters;
+
+    void clear() {
+        events.clear();
+        timers.clear();
+        counters.clear();
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadData *> live;
+    // data of threads that have exited, e.g. the workers of util::forEachTaskParallel
+    ThreadData retired;
+    std::vector<std::uint32_t> freeIds;
+    std::uint32_t nextId = 0;
+    std::map<std::string, ValueSummary> gauges;
+    std::vector<GaugeEvent> gaugeEvents;
+};
+
+Registry &registry() {
+    static Registry registry;
+    return registry;
+}
+
+// Registers the data of a thread on first use and merges it into the registry when the thread
+// exits. Thread ids are reused, which keeps the number of lanes in the trace small.
+struct ThreadHandle {
+    ThreadData data;
+
+    ThreadHandle() {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (reg.freeIds.empty()) {
+            data.tid = reg.nextId++;
+        } else {
+            data.tid = reg.freeIds.back();
+            reg.freeIds.pop_back();
+        }
+        reg.live.push_back(&data);
+    }
+
+    ~ThreadHandle() {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.live.erase(std::find(reg.live.begin(), reg.live.end(), &data));
+        reg.freeIds.push_back(data.tid);
+        const size_t count =
+            std::min(data.events.size(), maxRetiredEvents - reg.retired.events.size());
+        reg.retired.events.insert(reg.retired.events.end(), data.events.begin(),
+                                  data.events.begin() + count);
+        for (const auto &timer : data.timers) {
+            reg.retired.timers[timer.first].merge(timer.second);
+        }
+        for (const auto &counter : data.counters) {
+            reg.retired.counters[counter.first] += counter.second;
+        }
+    }
+};
+
+ThreadData &threadData() {
+    thread_local ThreadHandle handle;
+    return handle.data;
+}
+
+// calls func(ThreadData&) for the data of all live and exited threads
+template <typename Func>
+void forEachThreadData(Registry &reg, Func func) {
+    func(reg.retired);
+    for (auto data : reg.live) {
+        std::lock_guard<std::mutex> lock(data->mutex);
+        func(*data);
+    }
+}
+
+void writeJsonString(std::ostream &os, const char *str) {
+    os << '"';
+    for (; *str; ++str) {
+        switch (*str) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(*str) < 0x20) {
+                    os << ' ';
+                } else {
+                    os << *str;
+                }
+        }
+    }
+    os << '"';
+}
+
+}  // namespace
+
+bool isAvailable() {
+#ifdef IVW_DD2257_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+void setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+void reset() {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    forEachThreadData(reg, [](ThreadData &data) { data.clear(); });
+    reg.gauges.clear();
+    reg.gaugeEvents.clear();
+}
+
+std::vector<TimerSummary> getTimers() {
+    std::map<std::string, TimerStat> stats;
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        forEachThreadData(reg, [&](ThreadData &data) {
+            for (const auto &timer : data.timers) {
+                stats[timer.first].merge(timer.second);
+            }
+        });
+    }
+    std::vector<TimerSummary> result;
+    for (const auto &stat : stats) {
+        TimerSummary summary;
+        summary.name = stat.first;
+        summary.calls = stat.second.calls;
+        summary.totalMs = stat.second.totalMs;
+        summary.minMs = stat.second.minMs;
+        summary.maxMs = stat.second.maxMs;
+        result.push_back(summary);
+    }
+    std::stable_sort(result.begin(), result.end(),
+                     [](const TimerSummary &a, const TimerSummary &b) {
+                         return a.totalMs > b.totalMs;
+                     });
+    return result;
+}
+
+std::vector<ValueSummary> getCounters() {
+    std::map<std::string, std::int64_t> counters;
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        forEachThreadData(reg, [&](ThreadData &data) {
+            for (const auto &counter : data.counters) {
+                counters[counter.first] += counter.second;
+            }
+        });
+    }
+    std::vector<ValueSummary> result;
+    for (const auto &counter : counters) {
+        ValueSummary summary;
+        summary.name = counter.first;
+        summary.value = counter.second;
+        summary.maxValue = counter.second;
+        result.push_back(summary);
+    }
+    return result;
+}
+
+std::vector<ValueSummary> getGauges() {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<ValueSummary> result;
+    for (const auto &gauge : reg.gauges) {
+        result.push_back(gauge.second);
+    }
+    return result;
+}
+
+std::string formatSummary() {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    const auto timers = getTimers();
+    if (!timers.empty()) {
+        ss << std::left << std::setw(40) << "Timer" << std::right << std::setw(10) << "Calls"
+           << std::setw(14) << "Total (ms)" << std::setw(12) << "Mean (ms)" << std::setw(12)
+           << "Min (ms)" << std::setw(12) << "Max (ms)" << '\n';
+        for (const auto &t : timers) {
+            ss << std::left << std::setw(40) << t.name << std::right << std::setw(10) << t.calls
+               << std::setw(14) << t.totalMs << std::setw(12)
+               << t.totalMs / static_cast<double>(t.calls) << std::setw(12) << t.minMs
+               << std::setw(12) << t.maxMs << '\n';
+        }
+    }
+    const auto writeValues = [&](const std::string &title, const std::vector<ValueSummary> &values,
+                                 bool withMax) {
+        if (values.empty()) return;
+        ss << std::left << std::setw(40) << title << std::right << std::setw(20) << "Value";
+        if (withMax) ss << std::setw(20) << "Max";
+        ss << '\n';
+        for (const auto &v : values) {
+            ss << std::left << std::setw(40) << v.name << std::right << std::setw(20) << v.value;
+            if (withMax) ss << std::setw(20) << v.maxValue;
+            ss << '\n';
+        }
+    };
+    writeValues("Counter", getCounters(), false);
+    writeValues("Gauge (bytes)", getGauges(), true);
+    return ss.str();
+}
+
+void writeChromeTrace(std::ostream &os) {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    const auto writeTime = [&](std::int64_t ns) {
+        // microseconds with nanosecond resolution
+        os << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000
+           << std::setfill(' ');
+    };
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&]() {
+        if (!first) os << ",\n";
+        first = false;
+    };
+    const auto writeEvents = [&](const ThreadData &data) {
+        for (const auto &e : data.events) {
+            separator();
+            os << "{\"name\":";
+            writeJsonString(os, e.name);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid << ",\"ts\":";
+            writeTime(e.startNs);
+            os << ",\"dur\":";
+            writeTime(e.durationNs);
+            os << '}';
+        }
+    };
+    writeEvents(reg.retired);
+    for (auto data : reg.live) {
+        std::lock_guard<std::mutex> dataLock(data->mutex);
+        writeEvents(*data);
+    }
+    for (const auto &e : reg.gaugeEvents) {
+        separator();
+        os << "{\"name\":";
+        writeJsonString(os, e.name);
+        os << ",\"ph\":\"C\",\"pid\":1,\"ts\":";
+        writeTime(e.timeNs);
+        os << ",\"args\":{\"bytes\":" << e.value << "}}";
+    }
+    os << "]}\n";
+}
+
+void addToCounter(const char *name, std::int64_t value) {
+    if (!isEnabled()) return;
+    auto &data = threadData();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.counters[name] += value;
+}
+
+void setGauge(const char *name, std::int64_t bytes) {
+    if (!isEnabled()) return;
+    const auto now = toNs(Clock::now());
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto &gauge = reg.gauges[name];
+    if (gauge.name.empty()) {
+        gauge.name = name;
+        gauge.maxValue = bytes;
+    }
+    gauge.value = bytes;
+    gauge.maxValue = std::max(gauge.maxValue, bytes);
+    if (reg.gaugeEvents.size() < maxEventsPerThread) {
+        reg.gaugeEvents.push_back({name, now, bytes});
+    }
+}
+
+namespace detail {
+
+void recordInterval(const char *name, Clock::time_point start, Clock::time_point end) {
+    auto &data = threadData();
+    const auto startNs = toNs(start);
+    const auto durationNs = toNs(end) - startNs;
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.timers[name].add(static_cast<double>(durationNs) * 1e-6);
+    if (data.events.size() < maxEventsPerThread) {
+        data.events.push_back({name, startNs, durationNs, data.tid});
+    }
+}
+
+}  // namespace detail
+
+}  // namespace instrumentation
+
+}  // namespace inviwo
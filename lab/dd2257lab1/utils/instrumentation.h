@@ -0,0 +1,152 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_INSTRUMENTATION_H
+#define IVW_INSTRUMENTATION_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * Instrumentation of the hot paths of the DD2257 lab modules: scoped timers, counters and
+ * byte gauges. Use the macros below, they compile to nothing unless
+ * IVW_DD2257_INSTRUMENTATION is defined (CMake option of the DD2257Lab1 module). When compiled
+ * in, recording is additionally switched on and off at runtime, e.g. by the Instrumentation
+ * processor, and costs a single atomic load while switched off.
+ *
+ * Names have to be string literals or otherwise outlive the recorded data.
+ *
+ *     void MyProcessor::process() {
+ *         DD2257_SCOPED_TIMER("MyProcessor::process");
+ *         ...
+ *         DD2257_COUNTER("MyProcessor::vertices", vertices.size());
+ *         DD2257_GAUGE("MyProcessor::meshBytes", vertices.size() * sizeof(BasicMesh::Vertex));
+ *     }
+ */
+#ifdef IVW_DD2257_INSTRUMENTATION
+#define DD2257_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define DD2257_INSTRUMENTATION_CONCAT(a, b) DD2257_INSTRUMENTATION_CONCAT_IMPL(a, b)
+#define DD2257_SCOPED_TIMER(name)                                                           \
+    ::inviwo::instrumentation::ScopedTimer DD2257_INSTRUMENTATION_CONCAT(dd2257ScopedTimer, \
+                                                                         __LINE__)(name)
+#define DD2257_COUNTER(name, value) \
+    ::inviwo::instrumentation::addToCounter(name, static_cast<std::int64_t>(value))
+#define DD2257_GAUGE(name, bytes) \
+    ::inviwo::instrumentation::setGauge(name, static_cast<std::int64_t>(bytes))
+#else
+#define DD2257_SCOPED_TIMER(name) ((void)0)
+#define DD2257_COUNTER(name, value) ((void)0)
+#define DD2257_GAUGE(name, bytes) ((void)0)
+#endif
+
+namespace inviwo {
+
+namespace instrumentation {
+
+/// whether instrumentation was compiled in, see IVW_DD2257_INSTRUMENTATION
+IVW_MODULE_DD2257LAB1_API bool isAvailable();
+
+/// recording is off by default, switching it off keeps the data recorded so far
+IVW_MODULE_DD2257LAB1_API bool isEnabled();
+IVW_MODULE_DD2257LAB1_API void setEnabled(bool enabled);
+
+/// discards all recorded timings, counters and gauges
+IVW_MODULE_DD2257LAB1_API void reset();
+
+struct IVW_MODULE_DD2257LAB1_API TimerSummary {
+    std::string name;
+    size_t calls = 0;
+    double totalMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+struct IVW_MODULE_DD2257LAB1_API ValueSummary {
+    std::string name;
+    std::int64_t value = 0;  ///< sum for counters, last value for gauges
+    std::int64_t maxValue = 0;
+};
+
+/// timers summed over all threads, sorted by decreasing total time
+IVW_MODULE_DD2257LAB1_API std::vector<TimerSummary> getTimers();
+/// counters summed over all threads, sorted by name
+IVW_MODULE_DD2257LAB1_API std::vector<ValueSummary> getCounters();
+/// gauges sorted by name
+IVW_MODULE_DD2257LAB1_API std::vector<ValueSummary> getGauges();
+
+/**
+ * \brief plain text table of all timers, counters and gauges, e.g. for the log
+ */
+IVW_MODULE_DD2257LAB1_API std::string formatSummary();
+
+/**
+ * \brief writes the recorded timer intervals and gauge changes in the Chrome trace event
+ * format, which can be opened in chrome://tracing or https://ui.perfetto.dev. Each thread
+ * keeps at most a fixed number of events, the summaries include dropped events though.
+ */
+IVW_MODULE_DD2257LAB1_API void writeChromeTrace(std::ostream &os);
+
+IVW_MODULE_DD2257LAB1_API void addToCounter(const char *name, std::int64_t value);
+IVW_MODULE_DD2257LAB1_API void setGauge(const char *name, std::int64_t bytes);
+
+namespace detail {
+IVW_MODULE_DD2257LAB1_API void recordInterval(const char *name,
+                                              std::chrono::steady_clock::time_point start,
+                                              std::chrono::steady_clock::time_point end);
+}  // namespace detail
+
+/**
+ * \brief records the time between construction and destruction, if recording is enabled at
+ * construction
+ */
+class IVW_MODULE_DD2257LAB1_API ScopedTimer {
+public:
+    explicit ScopedTimer(const char *name) : name_(isEnabled() ? name : nullptr) {
+        if (name_) start_ = std::chrono::steady_clock::now();
+    }
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+    ~ScopedTimer() {
+        if (name_) detail::recordInterval(name_, start_, std::chrono::steady_clock::now());
+    }
+
+private:
+    const char *name_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace instrumentation
+
+}  // namespace inviwo
+
+#endif  // IVW_INSTRUMENTATION_H
@@ -0,0 +1,143 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/instrumentationsummary.h>
+#include <dd2257lab1/utils/instrumentation.h>
+
+#include <fstream>
+#include <limits>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo InstrumentationSummary::processorInfo_{
+    "org.inviwo.InstrumentationSummary",      // Class identifier
+    "Instrumentation",                        // Display name
+    "DD2257",                                 // Category
+    CodeState::Experimental,                  // Code state
+    "CPU, DataFrame, Profiling",              // Tags
+};
+const ProcessorInfo InstrumentationSummary::getProcessorInfo() const { return processorInfo_; }
+
+InstrumentationSummary::InstrumentationSummary()
+    : Processor()
+    , outport_("summary")
+    , record_("record", "Record", false)
+    , update_("update", "Update Summary")
+    , logSummary_("logSummary", "Log Summary", true)
+    , reset_("reset", "Reset")
+    , traceFile_("traceFile", "Trace File", "", "trace")
+    , exportTrace_("exportTrace", "Export Trace") {
+
+    addPort(outport_);
+
+    addProperty(record_);
+    addProperty(update_);
+    addProperty(logSummary_);
+    addProperty(reset_);
+    addProperty(traceFile_);
+    addProperty(exportTrace_);
+
+    traceFile_.setAcceptMode(AcceptMode::Save);
+
+    record_.setReadOnly(!instrumentation::isAvailable());
+    record_.onChange([&]() { instrumentation::setEnabled(record_.get()); });
+    reset_.onChange([]() { instrumentation::reset(); });
+    exportTrace_.onChange([&]() { exportTrace(); });
+}
+
+void InstrumentationSummary::exportTrace() {
+    if (traceFile_.get().empty()) {
+        LogProcessorWarn("No trace file given");
+        return;
+    }
+    std::ofstream file(traceFile_.get(), std::ios::out | std::ios::trunc);
+    if (!file) {
+        LogProcessorError("Could not open trace file " << traceFile_.get());
+        return;
+    }
+    instrumentation::writeChromeTrace(file);
+}
+
+void InstrumentationSummary::process() {
+    if (!instrumentation::isAvailable()) {
+        LogProcessorWarn(
+            "Instrumentation is not compiled in, enable IVW_DD2257_INSTRUMENTATION in CMake");
+    }
+
+    const auto timers = instrumentation::getTimers();
+    const auto counters = instrumentation::getCounters();
+    const auto gauges = instrumentation::getGauges();
+    const size_t rows = timers.size() + counters.size() + gauges.size();
+
+    auto summary = std::make_shared<DataFrame>(static_cast<std::uint32_t>(rows));
+    auto name = summary->addCategoricalColumn("Name");
+    auto type = summary->addCategoricalColumn("Type");
+    auto calls = summary->addColumn<std::int64_t>("Calls", rows);
+    auto total = summary->addColumn<double>("Total (ms)", rows);
+    auto mean = summary->addColumn<double>("Mean (ms)", rows);
+    auto max = summary->addColumn<double>("Max (ms)", rows);
+    auto value = summary->addColumn<double>("Value", rows);
+
+    // columns that do not apply to a row are NaN
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    size_t row = 0;
+    for (const auto &t : timers) {
+        name->add(t.name);
+        type->add("timer");
+        calls->set(row, static_cast<std::int64_t>(t.calls));
+        total->set(row, t.totalMs);
+        mean->set(row, t.totalMs / static_cast<double>(t.calls));
+        max->set(row, t.maxMs);
+        value->set(row, nan);
+        ++row;
+    }
+    const auto addValues = [&](const std::vector<instrumentation::ValueSummary> &values,
+                               const std::string &typeName) {
+        for (const auto &v : values) {
+            name->add(v.name);
+            type->add(typeName);
+            calls->set(row, 0);
+            total->set(row, nan);
+            mean->set(row, nan);
+            max->set(row, nan);
+            value->set(row, static_cast<double>(v.value));
+            ++row;
+        }
+    };
+    addValues(counters, "counter");
+    addValues(gauges, "gauge");
+
+    if (logSummary_.get() && rows > 0) {
+        LogProcessorInfo("\n" << instrumentation::formatSummary());
+    }
+    outport_.setData(summary);
+}
+
+}  // namespace inviwo
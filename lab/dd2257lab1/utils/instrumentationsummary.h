@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_INSTRUMENTATIONSUMMARY_H
+#define IVW_INSTRUMENTATIONSUMMARY_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+
+#include <dd2257lab1/utils/dataframe.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/buttonproperty.h>
+#include <inviwo/core/properties/fileproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.InstrumentationSummary, Instrumentation}
+ * ![](org.inviwo.InstrumentationSummary.png?classIdentifier=org.inviwo.InstrumentationSummary)
+ * Controls the instrumentation of the DD2257 lab modules and summarizes the recorded timers,
+ * counters and gauges, \see instrumentation.h. Instrumentation has to be compiled in with the
+ * CMake option IVW_DD2257_INSTRUMENTATION, the processor does not record anything otherwise.
+ *
+ * ### Outports
+ *   * __summary__  one row per timer, counter and gauge
+ *
+ * ### Properties
+ *   * __Record__          switches recording on and off for all processors
+ *   * __Update Summary__  refreshes the summary with the data recorded so far
+ *   * __Log Summary__     also writes the summary as a table to the log
+ *   * __Reset__           discards all recorded data
+ *   * __Trace File__      file the Chrome trace (JSON) is written to
+ *   * __Export Trace__    writes the recorded timers and gauges to the trace file
+ */
+class IVW_MODULE_DD2257LAB1_API InstrumentationSummary : public Processor {
+public:
+    InstrumentationSummary();
+    virtual ~InstrumentationSummary() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    void exportTrace();
+
+    DataFrameOutport outport_;
+
+    BoolProperty record_;
+    ButtonProperty update_;
+    BoolProperty logSummary_;
+    ButtonProperty reset_;
+    FileProperty traceFile_;
+    ButtonProperty exportTrace_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_INSTRUMENTATIONSUMMARY_H
@@ -0,0 +1,176 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+#ifdef WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string &fileName)
+    : data_(nullptr), size_(0), fileHandle_(nullptr), mappingHandle_(nullptr) {
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw FileException("MemoryMappedFile: Could not open file \"" + fileName + "\".");
+    }
+    fileHandle_ = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        unmap();
+        throw FileException("MemoryMappedFile: Could not query size of \"" + fileName + "\".");
+    }
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if (size_ == 0) {
+        // empty files cannot be mapped, there is nothing to read anyway
+        return;
+    }
+
+    mappingHandle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle_) {
+        unmap();
+        throw FileException("MemoryMappedFile: Could not map file \"" + fileName + "\".");
+    }
+    data_ = static_cast<const char *>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        unmap();
+        throw FileException("MemoryMappedFile: Could not map file \"" + fileName + "\".");
+    }
+}
+
+void MemoryMappedFile::unmap() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mappingHandle_) CloseHandle(mappingHandle_);
+    if (fileHandle_) CloseHandle(fileHandle_);
+    data_ = nullptr;
+    size_ = 0;
+    mappingHandle_ = nullptr;
+    fileHandle_ = nullptr;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile &&rhs)
+    : data_(rhs.data_)
+    , size_(rhs.size_)
+    , fileHandle_(rhs.fileHandle_)
+    , mappingHandle_(rhs.mappingHandle_) {
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+    rhs.fileHandle_ = nullptr;
+    rhs.mappingHandle_ = nullptr;
+}
+
+MemoryMappedFile &MemoryMappedFile::operator=(MemoryMappedFile &&rhs) {
+    if (this != &rhs) {
+        unmap();
+        std::swap(data_, rhs.data_);
+        std::swap(size_, rhs.size_);
+        std::swap(fileHandle_, rhs.fileHandle_);
+        std::swap(mappingHandle_, rhs.mappingHandle_);
+    }
+    return *this;
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string &fileName) : data_(nullptr), size_(0) {
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw FileException("MemoryMappedFile: Could not open file \"" + fileName + "\".");
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == -1) {
+        ::close(fd);
+        throw FileException("MemoryMappedFile: Could not query size of \"" + fileName + "\".");
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+        // empty files cannot be mapped, there is nothing to read anyway
+        ::close(fd);
+        return;
+    }
+
+    void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the file descriptor
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        size_ = 0;
+        throw FileException("MemoryMappedFile: Could not map file \"" + fileName + "\".");
+    }
+    // files are parsed front to back, let the kernel read ahead aggressively
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char *>(addr);
+}
+
+void MemoryMappedFile::unmap() {
+    if (data_) {
+        ::munmap(const_cast<char *>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile &&rhs) : data_(rhs.data_), size_(rhs.size_) {
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+}
+
+MemoryMappedFile &MemoryMappedFile::operator=(MemoryMappedFile &&rhs) {
+    if (this != &rhs) {
+        unmap();
+        std::swap(data_, rhs.data_);
+        std::swap(size_, rhs.size_);
+    }
+    return *this;
+}
+
+#endif
+
+MemoryMappedFile::~MemoryMappedFile() { unmap(); }
+
+const char *MemoryMappedFile::data() const { return data_; }
+
+size_t MemoryMappedFile::size() const { return size_; }
+
+const char *MemoryMappedFile::begin() const { return data_; }
+
+const char *MemoryMappedFile::end() const { return data_ + size_; }
+
+}  // namespace inviwo
@@ -0,0 +1,80 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_MEMORYMAPPEDFILE_H
+#define IVW_MEMORYMAPPEDFILE_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+namespace inviwo {
+
+/**
+ * \class MemoryMappedFile
+ * \brief Read-only view of an entire file mapped into the address space of the process.
+ *
+ * The pages are backed by the file itself, i.e. they are only loaded on access and can be
+ * evicted by the OS at any time. This allows to work on very large files without holding a
+ * private copy in memory. The mapping is released on destruction.
+ */
+class IVW_MODULE_DD2257LAB1_API MemoryMappedFile {
+public:
+    /**
+     * \brief maps the given file into memory
+     *
+     * @param fileName   file to be mapped
+     * @throws FileException if the file cannot be opened or mapped
+     */
+    explicit MemoryMappedFile(const std::string &fileName);
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile(MemoryMappedFile &&rhs);
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(MemoryMappedFile &&rhs);
+    ~MemoryMappedFile();
+
+    const char *data() const;
+    size_t size() const;
+
+    const char *begin() const;
+    const char *end() const;
+
+private:
+    void unmap();
+
+    const char *data_;
+    size_t size_;
+#ifdef WIN32
+    void *fileHandle_;
+    void *mappingHandle_;
+#endif
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_MEMORYMAPPEDFILE_H
@@ -0,0 +1,223 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/numberparser.h>
+
+#include <array>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <locale>
+#include <sstream>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <locale.h>
+#elif defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+bool isSpace(char ch) { return (ch == ' ') || (ch == '\t') || (ch == '\r'); }
+
+void trim(const char *&first, const char *&last) {
+    while ((first != last) && isSpace(*first)) ++first;
+    while ((first != last) && isSpace(*(last - 1))) --last;
+}
+
+bool equalsIgnoreCase(const char *first, const char *last, const char *str) {
+    for (; first != last; ++first, ++str) {
+        if ((*str == 0) || ((*first | 0x20) != *str)) return false;
+    }
+    return *str == 0;
+}
+
+// powers of ten which are exactly representable as double
+const std::array<double, 23> exactPowersOfTen = {
+    {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22}};
+
+/**
+ * Correctly rounded conversion for the rare cases not covered by the fast path. The "C"
+ * locale is used explicitly, the global locale might use a different decimal separator.
+ */
+double parseDoubleSlow(const char *first, const char *last) {
+    const std::string str(first, last);
+#if defined(_MSC_VER)
+    static const _locale_t cLocale = _create_locale(LC_NUMERIC, "C");
+    return _strtod_l(str.c_str(), nullptr, cLocale);
+#elif defined(__GLIBC__) || defined(__APPLE__)
+    static const locale_t cLocale = newlocale(LC_NUMERIC_MASK, "C", nullptr);
+    return strtod_l(str.c_str(), nullptr, cLocale);
+#else
+    std::istringstream stream(str);
+    stream.imbue(std::locale::classic());
+    double result = 0.0;
+    stream >> result;
+    return result;
+#endif
+}
+
+}  // namespace
+
+bool isBlank(const char *first, const char *last) {
+    trim(first, last);
+    return first == last;
+}
+
+bool parseInteger(const char *first, const char *last, std::int64_t &value) {
+    trim(first, last);
+    if (first == last) return false;
+
+    const bool negative = (*first == '-');
+    if ((*first == '-') || (*first == '+')) ++first;
+    if (first == last) return false;
+
+    // accumulate as negative number to cover the full range of int64
+    const std::int64_t minValue = std::numeric_limits<std::int64_t>::lowest();
+    std::int64_t result = 0;
+    for (; first != last; ++first) {
+        const unsigned int digit = static_cast<unsigned char>(*first) - '0';
+        if (digit > 9) return false;
+        if (result < (minValue + static_cast<std::int64_t>(digit)) / 10) return false;
+        result = result * 10 - static_cast<std::int64_t>(digit);
+    }
+    if (!negative) {
+        if (result == minValue) return false;
+        result = -result;
+    }
+    value = result;
+    return true;
+}
+
+bool parseDouble(const char *first, const char *last, double &value, size_t *significantDigits) {
+    trim(first, last);
+    if (first == last) return false;
+
+    const char *const start = first;
+    const bool negative = (*first == '-');
+    if ((*first == '-') || (*first == '+')) ++first;
+    if (first == last) return false;
+
+    if (equalsIgnoreCase(first, last, "nan")) {
+        value = std::numeric_limits<double>::quiet_NaN();
+        if (significantDigits) *significantDigits = 0;
+        return true;
+    }
+    if (equalsIgnoreCase(first, last, "inf") || equalsIgnoreCase(first, last, "infinity")) {
+        value = negative ? -std::numeric_limits<double>::infinity()
+                         : std::numeric_limits<double>::infinity();
+        if (significantDigits) *significantDigits = 0;
+        return true;
+    }
+
+    std::uint64_t mantissa = 0;
+    size_t digits = 0;         // digits stored in the mantissa, excluding leading zeros
+    size_t trailingZeros = 0;  // zeros at the end of the digit sequence
+    bool truncated = false;    // more than 19 significant digits
+    std::int64_t exponent = 0;
+    bool anyDigit = false;
+    bool decimalPoint = false;
+
+    for (; first != last; ++first) {
+        const char ch = *first;
+        if (ch == '.') {
+            if (decimalPoint) return false;
+            decimalPoint = true;
+            continue;
+        }
+        const unsigned int digit = static_cast<unsigned char>(ch) - '0';
+        if (digit > 9) break;
+        anyDigit = true;
+        if ((digit == 0) && (digits == 0)) {
+            // leading zero
+            if (decimalPoint) --exponent;
+            continue;
+        }
+        trailingZeros = (digit == 0) ? trailingZeros + 1 : 0;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + digit;
+            ++digits;
+            if (decimalPoint) --exponent;
+        } else {
+            truncated |= (digit != 0);
+            ++digits;
+            if (!decimalPoint) ++exponent;
+        }
+    }
+    if (!anyDigit) return false;
+
+    if ((first != last) && ((*first == 'e') || (*first == 'E'))) {
+        ++first;
+        if (first == last) return false;
+        const bool negativeExp = (*first == '-');
+        if ((*first == '-') || (*first == '+')) ++first;
+        if (first == last) return false;
+        std::int64_t exp = 0;
+        for (; first != last; ++first) {
+            const unsigned int digit = static_cast<unsigned char>(*first) - '0';
+            if (digit > 9) return false;
+            // saturate, such exponents result in zero or infinity anyway
+            if (exp < 100000) exp = exp * 10 + digit;
+        }
+        exponent += negativeExp ? -exp : exp;
+    }
+    if (first != last) return false;
+
+    if (significantDigits) *significantDigits = digits - trailingZeros;
+
+    // fast path: both the mantissa and the power of ten are exact, so is the result
+    const std::uint64_t maxExactMantissa = std::uint64_t{1} << 53;
+    if (!truncated && (mantissa <= maxExactMantissa) && (exponent >= -22) && (exponent <= 22)) {
+        double result = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            result /= exactPowersOfTen[static_cast<size_t>(-exponent)];
+        } else {
+            result *= exactPowersOfTen[static_cast<size_t>(exponent)];
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+    if (mantissa == 0) {
+        value = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    value = parseDoubleSlow(start, last);
+    return true;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,128 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_NUMBERPARSER_H
+#define IVW_NUMBERPARSER_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Locale-independent parsing of numbers from character ranges, similar to std::from_chars.
+ * Leading and trailing whitespace is ignored, any other surrounding characters cause the
+ * parsing to fail.
+ */
+
+/**
+ * \brief parses a decimal integer with optional sign
+ * @return false if [first, last) is not an integer or the value does not fit into int64
+ */
+IVW_MODULE_DD2257LAB1_API bool parseInteger(const char *first, const char *last,
+                                            std::int64_t &value);
+
+/**
+ * \brief parses a floating point number in decimal or scientific notation, as well as "nan",
+ * "inf", and "infinity" regardless of case.
+ *
+ * Numbers with at most 19 significant digits and a small exponent are converted exactly
+ * using double arithmetic. Other numbers fall back to the C library using the "C" locale.
+ *
+ * @param significantDigits  optional, number of significant digits excluding leading and
+ *                           trailing zeros, 0 for zero, nan, and inf
+ * @return false if [first, last) is not a number
+ */
+IVW_MODULE_DD2257LAB1_API bool parseDouble(const char *first, const char *last, double &value,
+                                           size_t *significantDigits = nullptr);
+
+/**
+ * \brief returns true if [first, last) is empty or contains only whitespace
+ */
+IVW_MODULE_DD2257LAB1_API bool isBlank(const char *first, const char *last);
+
+namespace detail {
+
+template <typename T>
+bool parseNumber(const char *first, const char *last, T &value, std::true_type /*integral*/) {
+    std::int64_t result;
+    if (!parseInteger(first, last, result)) return false;
+    if (std::is_unsigned<T>::value) {
+        if ((result < 0) ||
+            (static_cast<std::uint64_t>(result) > std::numeric_limits<T>::max())) {
+            return false;
+        }
+    } else if ((result < static_cast<std::int64_t>(std::numeric_limits<T>::lowest())) ||
+               (result > static_cast<std::int64_t>(std::numeric_limits<T>::max()))) {
+        return false;
+    }
+    value = static_cast<T>(result);
+    return true;
+}
+
+template <typename T>
+bool parseNumber(const char *first, const char *last, T &value, std::false_type /*integral*/) {
+    double result;
+    if (isBlank(first, last)) {
+        result = std::numeric_limits<double>::quiet_NaN();
+    } else if (!parseDouble(first, last, result)) {
+        return false;
+    } else if (std::isfinite(result) &&
+               (std::abs(result) > static_cast<double>(std::numeric_limits<T>::max()))) {
+        // finite values must not turn into infinity
+        return false;
+    }
+    value = static_cast<T>(result);
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * \brief parses an arithmetic value of type T from [first, last). For floating point types,
+ * an empty or blank range is considered a missing value and yields NaN.
+ * @return false if the range does not contain a number or the value does not fit into T
+ */
+template <typename T>
+bool parseNumber(const char *first, const char *last, T &value) {
+    return detail::parseNumber(first, last, value, std::is_integral<T>{});
+}
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_NUMBERPARSER_H
@@ -0,0 +1,151 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/parallel.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+/**
+ * Tasks of a single forEachTaskParallel call. Every thread executing the batch claims tasks
+ * until none are left, the batch is finished once all claimed tasks returned.
+ */
+class TaskBatch {
+public:
+    TaskBatch(size_t taskCount, const std::function<void(size_t)> &func)
+        : taskCount_(taskCount), func_(func) {}
+
+    void execute() {
+        for (size_t task = next_++; task < taskCount_; task = next_++) {
+            std::exception_ptr error;
+            try {
+                func_(task);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error && !error_) error_ = error;
+            if (++finished_ == taskCount_) done_.notify_all();
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return finished_ == taskCount_; });
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    const size_t taskCount_;
+    // only called for claimed tasks, i.e. while the caller waits for the batch
+    const std::function<void(size_t)> &func_;
+    std::atomic<size_t> next_{0};
+    size_t finished_ = 0;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount) : threadCount_(threadCount) {
+        for (size_t i = 0; i < threadCount; ++i) {
+            std::thread([this]() { work(); }).detach();
+        }
+    }
+
+    size_t getThreadCount() const { return threadCount_; }
+
+    void post(const std::shared_ptr<TaskBatch> &batch, size_t count) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.insert(queue_.end(), count, batch);
+        }
+        if (count == 1) {
+            available_.notify_one();
+        } else {
+            available_.notify_all();
+        }
+    }
+
+private:
+    void work() {
+        for (;;) {
+            std::shared_ptr<TaskBatch> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                available_.wait(lock, [this]() { return !queue_.empty(); });
+                batch = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            batch->execute();
+        }
+    }
+
+    const size_t threadCount_;
+    std::deque<std::shared_ptr<TaskBatch>> queue_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+};
+
+ThreadPool &getThreadPool() {
+    // never destroyed, the detached workers wait for work until the process exits. Joining
+    // them from a static destructor can dead lock while a shared library is unloaded.
+    static ThreadPool *pool = new ThreadPool(getHardwareThreadCount() - 1);
+    return *pool;
+}
+
+}  // namespace
+
+namespace detail {
+
+void runTasks(size_t taskCount, const std::function<void(size_t)> &func) {
+    auto &pool = getThreadPool();
+    auto batch = std::make_shared<TaskBatch>(taskCount, func);
+    // the calling thread executes tasks as well, at most taskCount - 1 workers are needed
+    pool.post(batch, std::min(taskCount - 1, pool.getThreadCount()));
+    batch->execute();
+    batch->wait();
+}
+
+}  // namespace detail
+
+}  // namespace util
+
+}  // namespace inviwo
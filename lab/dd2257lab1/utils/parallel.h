@@ -0,0 +1,157 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_PARALLEL_H
+#define IVW_PARALLEL_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief number of hardware threads available for parallel loops, at least one.
+ */
+inline size_t getHardwareThreadCount() {
+    return std::max<size_t>(1u, static_cast<size_t>(std::thread::hardware_concurrency()));
+}
+
+namespace detail {
+
+/**
+ * \brief runs \p func(task) for each task in [0, taskCount) on a persistent pool of
+ * getHardwareThreadCount() - 1 worker threads and the calling thread, see forEachTaskParallel.
+ */
+IVW_MODULE_DD2257LAB1_API void runTasks(size_t taskCount, const std::function<void(size_t)> &func);
+
+}  // namespace detail
+
+/**
+ * \brief calls \p func(task) for each task in [0, taskCount) in parallel. The tasks are run
+ * by a pool of worker threads, which is created once, and by the calling thread, which
+ * processes tasks until none are left. Calls from within a task are hence safe. The call
+ * blocks until all tasks are finished. The first exception caught in any of the tasks is
+ * rethrown.
+ */
+template <typename Func>
+void forEachTaskParallel(size_t taskCount, Func func) {
+    if (taskCount == 0) return;
+    if (taskCount == 1) {
+        func(size_t{0});
+        return;
+    }
+    detail::runTasks(taskCount, std::function<void(size_t)>(std::ref(func)));
+}
+
+/**
+ * \brief splits [0, size) into contiguous ranges of at least \p minRangeSize elements and calls
+ * \p func(begin, end, task) for each range in parallel. At most \p maxTasks ranges are
+ * used, 0 refers to the number of hardware threads. The call blocks until all ranges are
+ * processed.
+ *
+ * @return number of ranges, i.e. tasks, used
+ */
+template <typename Func>
+size_t forEachRangeParallel(size_t size, Func func, size_t minRangeSize = 1,
+                            size_t maxTasks = 0) {
+    if (size == 0) return 0;
+    if (maxTasks == 0) maxTasks = getHardwareThreadCount();
+    const size_t taskCount =
+        std::max<size_t>(1u, std::min(maxTasks, size / std::max<size_t>(1u, minRangeSize)));
+    forEachTaskParallel(taskCount, [&](size_t task) {
+        const size_t begin = size * task / taskCount;
+        const size_t end = size * (task + 1) / taskCount;
+        func(begin, end, task);
+    });
+    return taskCount;
+}
+
+/**
+ * \brief sorts [first, last) like std::stable_sort, i.e. the order of equal elements is
+ * preserved. Ranges of at least \p minRangeSize elements are sorted in parallel and merged
+ * pairwise afterwards, which requires a temporary copy of the elements.
+ */
+template <typename RandomIt, typename Compare>
+void parallelStableSort(RandomIt first, RandomIt last, Compare comp,
+                        size_t minRangeSize = size_t{1} << 14) {
+    using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+    const auto size = static_cast<size_t>(last - first);
+    const size_t taskCount = std::max<size_t>(
+        1u, std::min(getHardwareThreadCount(), size / std::max<size_t>(1u, minRangeSize)));
+    if (taskCount == 1) {
+        std::stable_sort(first, last, comp);
+        return;
+    }
+
+    std::vector<size_t> bounds;
+    for (size_t task = 0; task <= taskCount; ++task) {
+        bounds.push_back(size * task / taskCount);
+    }
+    forEachTaskParallel(taskCount, [&](size_t task) {
+        std::stable_sort(first + bounds[task], first + bounds[task + 1], comp);
+    });
+
+    // merge adjacent ranges until a single one is left. std::merge prefers elements of the
+    // first range, which keeps the sort stable.
+    std::vector<ValueType> tmp(size);
+    while (bounds.size() > 2) {
+        const size_t merges = (bounds.size() - 1) / 2;
+        forEachTaskParallel(merges, [&](size_t m) {
+            const auto begin = bounds[2 * m];
+            const auto mid = bounds[2 * m + 1];
+            const auto end = bounds[2 * m + 2];
+            std::merge(std::make_move_iterator(first + begin), std::make_move_iterator(first + mid),
+                       std::make_move_iterator(first + mid), std::make_move_iterator(first + end),
+                       tmp.begin() + begin, comp);
+            std::move(tmp.begin() + begin, tmp.begin() + end, first + begin);
+        });
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != size) {
+            merged.push_back(size);
+        }
+        bounds = std::move(merged);
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_PARALLEL_H
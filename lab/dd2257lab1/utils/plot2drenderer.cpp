@@ -31,6 +31,7 @@
 
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 #include <inviwo/core/interaction/trackball.h>
+#include <inviwo/core/metadata/metadata.h>
 #include <inviwo/core/rendering/meshdrawerfactory.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/common/inviwoapplication.h>
@@ -110,12 +111,20 @@ namespace inviwo
         utilgl::GlBoolState depthTest(GL_DEPTH_TEST, enableDepthTest_);
         utilgl::GlBoolState nvPointSize(GL_VERTEX_PROGRAM_POINT_SIZE_NV, true);
         utilgl::GlBoolState pointSprite(GL_POINT_SPRITE, true);
+        utilgl::GlBoolState primitiveRestart(GL_PRIMITIVE_RESTART, true);
+        glPrimitiveRestartIndex(plotPrimitiveRestartIndex);
 
         glPointSize(pointSize_.get());
 
         for (auto& drawer : drawers_)
         {
-            utilgl::setShaderUniforms(shader_, *(drawer.second->getMesh()), "geometry_");
+            const Mesh& mesh = *(drawer.second->getMesh());
+            utilgl::setShaderUniforms(shader_, mesh, "geometry_");
+            // only read if the mesh has no color buffer, the attribute array is disabled then
+            const vec4 color =
+                mesh.getMetaData<FloatVec4MetaData>(plotColorMetaDataKey, vec4(1.0f));
+            glVertexAttrib4f(static_cast<GLuint>(BufferType::ColorAttrib), color.r, color.g,
+                             color.b, color.a);
             drawer.second->draw();
         }
 
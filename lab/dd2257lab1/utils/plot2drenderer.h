@@ -38,11 +38,25 @@
 #include <inviwo/core/rendering/meshdrawer.h>
 #include <modules/opengl/shader/shader.h>
 #include <inviwo/core/properties/boolproperty.h>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace inviwo
 {
 
+    /**
+     * \brief index that ends the current strip in the index buffers of meshes drawn by the
+     * Plot2DRenderer, i.e. several line strips can share a single index buffer
+     */
+    constexpr std::uint32_t plotPrimitiveRestartIndex = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * \brief key of a FloatVec4MetaData holding the color of a mesh without a color buffer.
+     * The Plot2DRenderer passes it as constant color attribute instead of a vec4 per vertex.
+     */
+    constexpr const char* plotColorMetaDataKey = "plotColor";
+
     class IVW_MODULE_DD2257LAB1_API Plot2DRenderer : public Processor
     {
     public:
@@ -0,0 +1,126 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/plotmesh.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <dd2257lab1/utils/plot2drenderer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/metadata/metadata.h>
+#include <inviwo/core/util/exception.h>
+
+namespace inviwo {
+
+namespace {
+
+// vertices per task when rewriting colors
+constexpr size_t minVerticesPerTask = size_t{1} << 16;
+
+}  // namespace
+
+PlotMesh::PlotMesh(std::shared_ptr<Buffer<vec2>> positions, std::vector<float> colorScale)
+    : positions_(std::move(positions)), colorScale_(std::move(colorScale)) {
+    if (!colorScale_.empty() && colorScale_.size() != positions_->getSize()) {
+        throw Exception("PlotMesh: got " + std::to_string(colorScale_.size()) +
+                        " color scale values for " + std::to_string(positions_->getSize()) +
+                        " vertices");
+    }
+}
+
+PlotMesh::PlotMesh(std::vector<vec2> positions, std::vector<float> colorScale)
+    : PlotMesh(std::make_shared<Buffer<vec2>>(positions.size()), std::move(colorScale)) {
+    positions_->getEditableRAMRepresentation()->getDataContainer() = std::move(positions);
+}
+
+void PlotMesh::addIndices(Mesh::MeshInfo info, std::shared_ptr<IndexBuffer> indices) {
+    indices_.emplace_back(info, std::move(indices));
+}
+
+void PlotMesh::clearIndices() { indices_.clear(); }
+
+void PlotMesh::setColors(const vec4 &high, const vec4 &low) {
+    if (colorScale_.empty()) {
+        // uniform color, passed to the renderer with the mesh instead of a buffer
+        high_ = high;
+        low_ = low;
+        return;
+    }
+    if (colors_ && high == high_ && low == low_) return;
+
+    DD2257_SCOPED_TIMER("PlotMesh::setColors");
+    high_ = high;
+    low_ = low;
+    if (!colors_) {
+        colors_ = std::make_shared<Buffer<vec4>>(getNumberOfVertices());
+    }
+    // editable access drops the representations on the GPU, only the colors are uploaded again
+    auto &colors = colors_->getEditableRAMRepresentation()->getDataContainer();
+    util::forEachRangeParallel(colors.size(),
+                               [&](size_t begin, size_t end, size_t) {
+                                   for (size_t i = begin; i < end; ++i) {
+                                       colors[i] = glm::mix(low, high, colorScale_[i]);
+                                   }
+                               },
+                               minVerticesPerTask);
+}
+
+std::shared_ptr<Mesh> PlotMesh::getMesh(const vec2 &origin, const vec2 &size, float depth) const {
+    auto mesh = std::make_shared<Mesh>();
+    if (indices_.empty()) return mesh;
+    mesh->addBuffer(BufferType::PositionAttrib, positions_);
+    if (colors_) {
+        mesh->addBuffer(BufferType::ColorAttrib, colors_);
+    } else {
+        mesh->setMetaData<FloatVec4MetaData>(plotColorMetaDataKey, high_);
+    }
+    for (const auto &elem : indices_) {
+        mesh->addIndicies(elem.first, elem.second);
+    }
+    mat4 model(1.0f);
+    model[0][0] = size.x;
+    model[1][1] = size.y;
+    model[3][0] = origin.x;
+    model[3][1] = origin.y;
+    model[3][2] = depth;
+    mesh->setModelMatrix(model);
+    return mesh;
+}
+
+size_t PlotMesh::getSizeInBytes() const {
+    size_t bytes = positions_->getSize() * sizeof(vec2);
+    if (colors_) {
+        bytes += colors_->getSize() * sizeof(vec4);
+    }
+    for (const auto &elem : indices_) {
+        bytes += elem.second->getSize() * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+}  // namespace inviwo
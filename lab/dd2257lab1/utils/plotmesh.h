@@ -0,0 +1,105 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_PLOTMESH_H
+#define IVW_PLOTMESH_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <utility>
+
+namespace inviwo {
+
+/**
+ * \brief geometry of a plot drawn by the Plot2DRenderer, split into a data and a presentation
+ * part.
+ *
+ * The vertex positions and index buffers are given in normalized plot coordinates, i.e. the
+ * plot spans [0, 1]^2, and only have to be rebuilt when the data changes. The layout and
+ * the colors are applied afterwards: getMesh() places the plot with the model matrix of the
+ * mesh without touching any vertex, setColors() rewrites the vertex colors in place. Without
+ * a color scale there is no color buffer at all, the Plot2DRenderer then draws the whole mesh
+ * in the color stored under plotColorMetaDataKey.
+ */
+class IVW_MODULE_DD2257LAB1_API PlotMesh {
+public:
+    /**
+     * @param positions   vertex positions in normalized plot coordinates, the buffer may be
+     *                    shared with other plot meshes
+     * @param colorScale  optional value in [0, 1] per vertex, which interpolates between the
+     *                    low and the high color of setColors(). All vertices use the high
+     *                    color if empty.
+     * @throws Exception if colorScale is not empty and differs in size from positions
+     */
+    explicit PlotMesh(std::shared_ptr<Buffer<vec2>> positions,
+                      std::vector<float> colorScale = {});
+    /// \see PlotMesh(std::shared_ptr<Buffer<vec2>>, std::vector<float>)
+    explicit PlotMesh(std::vector<vec2> positions, std::vector<float> colorScale = {});
+
+    void addIndices(Mesh::MeshInfo info, std::shared_ptr<IndexBuffer> indices);
+    void clearIndices();
+    bool hasIndices() const { return !indices_.empty(); }
+
+    size_t getNumberOfVertices() const { return positions_->getSize(); }
+    const std::shared_ptr<Buffer<vec2>> &getPositions() const { return positions_; }
+
+    /**
+     * \brief sets the vertex colors, see colorScale. With a color scale the colors are
+     * rewritten in parallel and only if they differ from the current ones, otherwise only the
+     * uniform color is stored.
+     */
+    void setColors(const vec4 &high, const vec4 &low = vec4(0.0f));
+
+    /**
+     * \brief returns a mesh sharing the buffers of this plot mesh, whose model matrix maps
+     * [0, 1]^2 to the rectangle at \p origin with the given \p size. A positive \p depth
+     * moves the mesh towards the viewer, i.e. in front of meshes at depth zero. The mesh is
+     * empty if there are no indices, all vertices would be drawn as points otherwise.
+     */
+    std::shared_ptr<Mesh> getMesh(const vec2 &origin, const vec2 &size, float depth = 0.0f) const;
+
+    /// size of all vertex and index buffers in bytes
+    size_t getSizeInBytes() const;
+
+private:
+    std::shared_ptr<Buffer<vec2>> positions_;
+    std::shared_ptr<Buffer<vec4>> colors_;
+    std::vector<float> colorScale_;
+    std::vector<std::pair<Mesh::MeshInfo, std::shared_ptr<IndexBuffer>>> indices_;
+    vec4 high_{0.0f};
+    vec4 low_{0.0f};
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_PLOTMESH_H
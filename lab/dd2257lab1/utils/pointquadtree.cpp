@@ -0,0 +1,212 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/pointquadtree.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <inviwo/core/util/exception.h>
+
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+// bits per axis of the Morton codes, i.e. the maximum depth of the tree
+constexpr size_t maxDepth = 16;
+constexpr std::uint64_t invalidKey = std::numeric_limits<std::uint64_t>::max();
+
+// spreads the lower 16 bits of v to the even bits
+inline std::uint32_t spreadBits(std::uint32_t v) {
+    v &= 0x0000ffffu;
+    v = (v | (v << 8)) & 0x00ff00ffu;
+    v = (v | (v << 4)) & 0x0f0f0f0fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+inline std::uint32_t mortonCode(vec2 p) {
+    const auto quantize = [](float v) {
+        return std::min(static_cast<std::uint32_t>(v * 65536.0f), std::uint32_t{65535});
+    };
+    return spreadBits(quantize(p.x)) | (spreadBits(quantize(p.y)) << 1);
+}
+
+}  // namespace
+
+PointQuadtree::PointQuadtree(const std::vector<vec2> &positions,
+                             const std::vector<std::uint32_t> &rows, size_t leafSize)
+    : leafSize_(std::max<size_t>(1u, leafSize)) {
+    DD2257_SCOPED_TIMER("PointQuadtree::build");
+    if (!rows.empty() && rows.size() != positions.size()) {
+        throw Exception("Number of rows does not match the number of positions");
+    }
+
+    // sort keys combine the Morton code with the index of the position, which makes the order
+    // of points within the same cell deterministic
+    std::vector<std::uint64_t> keys(positions.size());
+    util::forEachRangeParallel(
+        positions.size(),
+        [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto &p = positions[i];
+                const bool valid = p.x >= 0.0f && p.x <= 1.0f && p.y >= 0.0f && p.y <= 1.0f;
+                keys[i] = valid ? (std::uint64_t{mortonCode(p)} << 32) | i : invalidKey;
+            }
+        },
+        size_t{1} << 14);
+    util::parallelStableSort(keys.begin(), keys.end(), std::less<std::uint64_t>());
+    keys.erase(std::lower_bound(keys.begin(), keys.end(), invalidKey), keys.end());
+
+    std::vector<std::uint32_t> codes(keys.size());
+    positions_.resize(keys.size());
+    rows_.resize(keys.size());
+    util::forEachRangeParallel(
+        keys.size(),
+        [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto idx = static_cast<std::uint32_t>(keys[i] & 0xffffffffu);
+                codes[i] = static_cast<std::uint32_t>(keys[i] >> 32);
+                positions_[i] = positions[idx];
+                rows_[i] = rows.empty() ? idx : rows[idx];
+            }
+        },
+        size_t{1} << 14);
+
+    if (positions_.empty()) return;
+    Node root;
+    root.min = vec2(0.0f);
+    root.max = vec2(1.0f);
+    root.begin = 0;
+    root.end = static_cast<std::uint32_t>(positions_.size());
+    nodes_.push_back(root);
+    split(0, 0, codes);
+}
+
+void PointQuadtree::split(std::uint32_t node, size_t depth,
+                          const std::vector<std::uint32_t> &codes) {
+    // nodes_ grows during the recursion, refer to nodes by index only
+    const auto begin = nodes_[node].begin;
+    const auto end = nodes_[node].end;
+    if (end - begin <= leafSize_ || depth == maxDepth) return;
+
+    // the two bits below the prefix of the node select the quadrant, x being the lower one
+    const auto shift = static_cast<std::uint32_t>(2 * (maxDepth - depth - 1));
+    const auto prefixMask = ~((std::uint64_t{1} << (shift + 2)) - 1);
+    const auto base = static_cast<std::uint32_t>(codes[begin] & prefixMask);
+    const vec2 min = nodes_[node].min;
+    const vec2 mid = 0.5f * (nodes_[node].min + nodes_[node].max);
+    const vec2 max = nodes_[node].max;
+
+    std::vector<Node> children;
+    auto first = codes.begin() + begin;
+    for (std::uint32_t q = 0; q < 4; ++q) {
+        const auto last =
+            q == 3 ? codes.begin() + end
+                   : std::lower_bound(first, codes.begin() + end, base | ((q + 1) << shift));
+        if (first != last) {
+            Node child;
+            child.min = vec2((q & 1) ? mid.x : min.x, (q & 2) ? mid.y : min.y);
+            child.max = vec2((q & 1) ? max.x : mid.x, (q & 2) ? max.y : mid.y);
+            child.begin = static_cast<std::uint32_t>(first - codes.begin());
+            child.end = static_cast<std::uint32_t>(last - codes.begin());
+            children.push_back(child);
+        }
+        first = last;
+    }
+
+    const auto firstChild = static_cast<std::uint32_t>(nodes_.size());
+    nodes_[node].firstChild = firstChild;
+    nodes_[node].childCount = static_cast<std::uint8_t>(children.size());
+    nodes_.insert(nodes_.end(), children.begin(), children.end());
+    for (std::uint32_t c = 0; c < children.size(); ++c) {
+        split(firstChild + c, depth + 1, codes);
+    }
+}
+
+PointQuadtree::Result PointQuadtree::query(vec2 viewMin, vec2 viewMax, size_t budget) const {
+    DD2257_SCOPED_TIMER("PointQuadtree::query");
+    Result result;
+    const auto isVisible = [&](const Node &n) {
+        return n.max.x >= viewMin.x && n.min.x <= viewMax.x && n.max.y >= viewMin.y &&
+               n.min.y <= viewMax.y;
+    };
+    // leaves are drawn with all their points, other nodes by a single representative
+    const auto cost = [](const Node &n) -> size_t { return n.isLeaf() ? n.size() : 1u; };
+
+    std::vector<std::uint32_t> frontier;
+    if (!nodes_.empty() && isVisible(nodes_.front())) {
+        frontier.push_back(0);
+    }
+
+    // refine all visible nodes by one level at a time, which keeps the level of detail
+    // uniform across the view, until the next level would exceed the budget
+    std::vector<std::uint32_t> next;
+    while (std::any_of(frontier.begin(), frontier.end(),
+                       [&](std::uint32_t n) { return !nodes_[n].isLeaf(); })) {
+        next.clear();
+        size_t nextCost = 0;
+        for (auto n : frontier) {
+            const auto &node = nodes_[n];
+            if (node.isLeaf()) {
+                next.push_back(n);
+                nextCost += cost(node);
+                continue;
+            }
+            for (std::uint32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c) {
+                if (isVisible(nodes_[c])) {
+                    next.push_back(c);
+                    nextCost += cost(nodes_[c]);
+                }
+            }
+        }
+        if (nextCost > budget) break;
+        std::swap(frontier, next);
+        ++result.level;
+    }
+
+    for (auto n : frontier) {
+        const auto &node = nodes_[n];
+        if (node.isLeaf()) {
+            for (auto i = node.begin; i < node.end; ++i) {
+                result.points.push_back(i);
+                result.counts.push_back(1u);
+            }
+        } else {
+            // the middle of the Z-order range lies within the node and is a fair sample
+            result.points.push_back(node.begin + node.size() / 2);
+            result.counts.push_back(node.size());
+        }
+    }
+    return result;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,103 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_POINTQUADTREE_H
+#define IVW_POINTQUADTREE_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+/**
+ * \brief quadtree over 2D points in [0, 1]^2 for view-dependent level of detail.
+ *
+ * The points are sorted along a Z-order (Morton) curve, every node thus covers a contiguous
+ * range of the sorted points. Nodes are split until they hold at most leafSize points or the
+ * maximum depth is reached. query() refines the nodes within a view level by level as long as
+ * the result fits into a point budget: nodes that are not refined further are represented by
+ * one of their points and the number of points they contain.
+ */
+class IVW_MODULE_DD2257LAB1_API PointQuadtree {
+public:
+    struct Node {
+        vec2 min;
+        vec2 max;
+        std::uint32_t begin;  ///< first point of the node in the sorted points
+        std::uint32_t end;
+        std::uint32_t firstChild = 0;  ///< 0 for leaves, children are stored consecutively
+        std::uint8_t childCount = 0;
+
+        bool isLeaf() const { return childCount == 0; }
+        std::uint32_t size() const { return end - begin; }
+    };
+
+    struct Result {
+        std::vector<std::uint32_t> points;  ///< indices into getPositions()/getRows()
+        std::vector<std::uint32_t> counts;  ///< number of points represented by each point
+        size_t level = 0;                   ///< deepest level that was refined completely
+    };
+
+    /**
+     * \brief builds the tree from \p positions, points with NaN or coordinates outside [0, 1]
+     * are skipped. \p rows gives the row of each position, e.g. the rows of a selection, the
+     * index of the position is used if it is empty.
+     * @throws Exception if rows is not empty and differs in size from positions
+     */
+    PointQuadtree(const std::vector<vec2> &positions, const std::vector<std::uint32_t> &rows = {},
+                  size_t leafSize = 64);
+
+    /**
+     * \brief returns the points to draw for the view [\p viewMin, \p viewMax], at most
+     * \p budget unless the view contains more leaves than the budget. All points of leaves
+     * within the view are returned once the budget allows it.
+     */
+    Result query(vec2 viewMin, vec2 viewMax, size_t budget) const;
+
+    /// positions sorted along the Z-order curve
+    const std::vector<vec2> &getPositions() const { return positions_; }
+    /// row of each sorted position
+    const std::vector<std::uint32_t> &getRows() const { return rows_; }
+    const std::vector<Node> &getNodes() const { return nodes_; }
+    size_t getNumberOfPoints() const { return positions_.size(); }
+
+private:
+    void split(std::uint32_t node, size_t depth, const std::vector<std::uint32_t> &codes);
+
+    size_t leafSize_;
+    std::vector<vec2> positions_;
+    std::vector<std::uint32_t> rows_;
+    std::vector<Node> nodes_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_POINTQUADTREE_H
@@ -0,0 +1,91 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/rowview.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+double toDouble(const void *data, size_t idx) {
+    return util::glm_convert<double>(static_cast<const T *>(data)[idx]);
+}
+
+template <typename T>
+std::string toString(const void *data, size_t idx) {
+    std::ostringstream ss;
+    ss << static_cast<const T *>(data)[idx];
+    return ss.str();
+}
+
+}  // namespace
+
+std::pair<const char *, const char *> RowView::getCategory(size_t col) const {
+    const auto &column = accessor_->getColumnData(col);
+    if (!column.dictionary) {
+        throw InvalidConversion("RowView: column is not categorical (col. " +
+                                std::to_string(col) + ")");
+    }
+    const auto id = static_cast<const std::uint32_t *>(column.data)[row_];
+    const char *first = column.dictionary->data(id);
+    return {first, first + column.dictionary->length(id)};
+}
+
+std::string RowView::getAsString(size_t col) const {
+    if (isCategorical(col)) {
+        const auto str = getCategory(col);
+        return std::string(str.first, str.second);
+    }
+    const auto &column = accessor_->getColumnData(col);
+    return column.toString(column.data, row_);
+}
+
+RowAccessor::RowAccessor(const DataFrame &dataFrame) : rows_(dataFrame.getNumberOfRows()) {
+    columns_.reserve(dataFrame.getNumberOfColumns());
+    for (auto column : dataFrame) {
+        auto ram = column->getBuffer()->getRepresentation<BufferRAM>();
+        columns_.push_back(
+            ram->dispatch<ColumnData, dispatching::filter::Scalars>([](auto buf) {
+                using BufferType = std::remove_cv_t<decltype(buf)>;
+                using ValueType = util::PrecsionValueType<BufferType>;
+                const auto &values = buf->getDataContainer();
+                return ColumnData{values.data(), values.size(),
+                                  std::type_index(typeid(ValueType)), &toDouble<ValueType>,
+                                  &toString<ValueType>, nullptr};
+            }));
+        if (auto categorical = dynamic_cast<const CategoricalColumn *>(column.get())) {
+            columns_.back().dictionary = &categorical->getDictionary();
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,165 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_ROWVIEW_H
+#define IVW_ROWVIEW_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/dataframe.h>
+
+#include <typeindex>
+
+namespace inviwo {
+
+class RowAccessor;
+
+/**
+ * \class RowView
+ * \brief Lightweight, non-owning view of a single row of a DataFrame. In contrast to
+ * DataFrame::getDataItem, values are read directly from the column buffers without creating
+ * DataPoints, i.e. without any memory allocation.
+ *
+ * Column 0 refers to the index column. Row indices are not checked against the size of
+ * individual columns.
+ *
+ * \see RowAccessor, forEachRow
+ */
+class IVW_MODULE_DD2257LAB1_API RowView {
+public:
+    RowView(const RowAccessor &accessor, size_t row) : accessor_(&accessor), row_(row) {}
+
+    size_t getIndex() const { return row_; }
+    size_t getNumberOfColumns() const;
+
+    /**
+     * \brief returns the value of column \p col, T has to match the data type of the column,
+     * e.g. std::uint32_t for categorical columns
+     *
+     * @throws InvalidConversion if T does not match the column type
+     */
+    template <typename T>
+    const T &get(size_t col) const;
+
+    double getAsDouble(size_t col) const;
+
+    bool isCategorical(size_t col) const;
+    /**
+     * \brief returns the string of a categorical value as character range [first, second)
+     * pointing into the dictionary of the column
+     *
+     * @throws InvalidConversion if the column is not categorical
+     */
+    std::pair<const char *, const char *> getCategory(size_t col) const;
+
+    /**
+     * \brief returns the value as string, categorical values are returned as the original
+     * string. Note that this allocates the returned string.
+     */
+    std::string getAsString(size_t col) const;
+
+private:
+    const RowAccessor *accessor_;
+    size_t row_;
+};
+
+/**
+ * \class RowAccessor
+ * \brief Resolves the data of all columns of a DataFrame once, which then can be accessed row
+ * by row through RowViews. The accessor and all its RowViews become invalid when the
+ * DataFrame or one of its columns is modified.
+ *
+ * Example:
+ *     RowAccessor rows(dataFrame);
+ *     for (size_t i = 0; i < rows.getNumberOfRows(); ++i) {
+ *         sum += rows[i].getAsDouble(1);
+ *     }
+ */
+class IVW_MODULE_DD2257LAB1_API RowAccessor {
+public:
+    /// typed data of a single column
+    struct ColumnData {
+        const void *data;
+        size_t size;
+        std::type_index type;
+        double (*toDouble)(const void *data, size_t idx);
+        std::string (*toString)(const void *data, size_t idx);
+        const StringDictionary *dictionary;  ///< categorical columns only, nullptr otherwise
+    };
+
+    explicit RowAccessor(const DataFrame &dataFrame);
+
+    RowView operator[](size_t row) const { return RowView(*this, row); }
+
+    size_t getNumberOfRows() const { return rows_; }
+    size_t getNumberOfColumns() const { return columns_.size(); }
+
+    const ColumnData &getColumnData(size_t col) const { return columns_[col]; }
+
+private:
+    std::vector<ColumnData> columns_;
+    size_t rows_;
+};
+
+/**
+ * \brief calls \p func(const RowView &) for every row of \p dataFrame
+ */
+template <typename Func>
+void forEachRow(const DataFrame &dataFrame, Func func) {
+    RowAccessor rows(dataFrame);
+    for (size_t i = 0; i < rows.getNumberOfRows(); ++i) {
+        func(rows[i]);
+    }
+}
+
+inline size_t RowView::getNumberOfColumns() const { return accessor_->getNumberOfColumns(); }
+
+template <typename T>
+const T &RowView::get(size_t col) const {
+    const auto &column = accessor_->getColumnData(col);
+    if (column.type != std::type_index(typeid(T))) {
+        throw InvalidConversion("RowView: requested type does not match column type (col. " +
+                                std::to_string(col) + ")");
+    }
+    return static_cast<const T *>(column.data)[row_];
+}
+
+inline double RowView::getAsDouble(size_t col) const {
+    const auto &column = accessor_->getColumnData(col);
+    return column.toDouble(column.data, row_);
+}
+
+inline bool RowView::isCategorical(size_t col) const {
+    return accessor_->getColumnData(col).dictionary != nullptr;
+}
+
+}  // namespace inviwo
+
+#endif  // IVW_ROWVIEW_H
@@ -0,0 +1,265 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/selection.h>
+#include <dd2257lab1/utils/bitops.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+// words per task when evaluating predicates in parallel, i.e. 256k rows
+constexpr size_t minWordsPerTask = 4096;
+
+size_t getWordCount(size_t size) { return (size + 63) / 64; }
+
+/**
+ * Evaluates pred for each value of the column and sets the corresponding bits. The inner
+ * loop has a fixed trip count of 64 and no branches, which allows vectorization.
+ */
+template <typename T, typename Pred>
+void evaluate(const T *values, size_t size, Pred pred, std::vector<std::uint64_t> &words) {
+    const size_t fullWords = size / 64;
+    util::forEachRangeParallel(fullWords,
+                               [&](size_t begin, size_t end, size_t) {
+                                   for (size_t w = begin; w < end; ++w) {
+                                       const T *v = values + w * 64;
+                                       std::uint64_t bits = 0;
+                                       for (size_t k = 0; k < 64; ++k) {
+                                           bits |= static_cast<std::uint64_t>(pred(v[k])) << k;
+                                       }
+                                       words[w] = bits;
+                                   }
+                               },
+                               minWordsPerTask);
+    // remaining rows
+    std::uint64_t bits = 0;
+    for (size_t i = fullWords * 64; i < size; ++i) {
+        bits |= static_cast<std::uint64_t>(pred(values[i])) << (i % 64);
+    }
+    if (size % 64 != 0) {
+        words[fullWords] = bits;
+    }
+}
+
+/**
+ * Calls func(const T *values, size_t size) with the typed values of the column
+ */
+template <typename Func>
+void dispatchValues(const Column &column, Func func) {
+    column.getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
+        [&](auto buf) {
+            const auto &values = buf->getDataContainer();
+            func(values.data(), values.size());
+        });
+}
+
+/**
+ * Evaluates pred(double) for each value of the column
+ */
+template <typename Pred>
+Selection selectValues(const Column &column, Pred pred) {
+    Selection selection(column.getSize());
+    dispatchValues(column, [&](const auto *values, size_t size) {
+        evaluate(values, size, [&](auto v) { return pred(static_cast<double>(v)); },
+                 selection.getEditableWords());
+    });
+    return selection;
+}
+
+const CategoricalColumn &getCategorical(const Column &column) {
+    auto categorical = dynamic_cast<const CategoricalColumn *>(&column);
+    if (!categorical) {
+        throw InvalidConversion("Selection: column \"" + column.getHeader() +
+                                "\" is not categorical");
+    }
+    return *categorical;
+}
+
+}  // namespace
+
+Selection::Selection(size_t size, bool selected)
+    : words_(getWordCount(size), selected ? ~std::uint64_t{0} : 0u), size_(size) {
+    if (selected && (size % 64 != 0)) {
+        words_.back() = (std::uint64_t{1} << (size % 64)) - 1;
+    }
+}
+
+void Selection::setSelected(size_t row, bool selected) {
+    indices_.reset();
+    const auto bit = std::uint64_t{1} << (row % 64);
+    if (selected) {
+        words_[row / 64] |= bit;
+    } else {
+        words_[row / 64] &= ~bit;
+    }
+}
+
+size_t Selection::count() const {
+    size_t result = 0;
+    for (auto word : words_) {
+        result += util::popCount(word);
+    }
+    return result;
+}
+
+Selection &Selection::operator&=(const Selection &rhs) {
+    if (size_ != rhs.size_) {
+        throw Exception("Selection: sizes do not match (" + std::to_string(size_) + " vs. " +
+                        std::to_string(rhs.size_) + ")");
+    }
+    indices_.reset();
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= rhs.words_[i];
+    }
+    return *this;
+}
+
+Selection &Selection::operator|=(const Selection &rhs) {
+    if (size_ != rhs.size_) {
+        throw Exception("Selection: sizes do not match (" + std::to_string(size_) + " vs. " +
+                        std::to_string(rhs.size_) + ")");
+    }
+    indices_.reset();
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] |= rhs.words_[i];
+    }
+    return *this;
+}
+
+void Selection::invert() {
+    indices_.reset();
+    for (auto &word : words_) {
+        word = ~word;
+    }
+    if (size_ % 64 != 0) {
+        words_.back() &= (std::uint64_t{1} << (size_ % 64)) - 1;
+    }
+}
+
+std::vector<std::uint64_t> &Selection::getEditableWords() {
+    indices_.reset();
+    return words_;
+}
+
+std::shared_ptr<IndexBuffer> Selection::getIndexBuffer() const {
+    if (!indices_) {
+        auto buffer = std::make_shared<IndexBuffer>();
+        auto &indices = buffer->getEditableRAMRepresentation()->getDataContainer();
+        // count the selected rows of each range of words first, each range then writes its
+        // indices starting at the total count of all preceding ranges. Both passes use the
+        // same ranges.
+        const size_t maxTasks = util::getHardwareThreadCount();
+        std::vector<size_t> offsets(maxTasks + 1, 0u);
+        util::forEachRangeParallel(words_.size(),
+                                   [&](size_t begin, size_t end, size_t task) {
+                                       size_t rows = 0;
+                                       for (size_t w = begin; w < end; ++w) {
+                                           rows += util::popCount(words_[w]);
+                                       }
+                                       offsets[task + 1] = rows;
+                                   },
+                                   minWordsPerTask, maxTasks);
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        indices.resize(offsets.back());
+        util::forEachRangeParallel(words_.size(),
+                                   [&](size_t begin, size_t end, size_t task) {
+                                       auto out = indices.data() + offsets[task];
+                                       for (size_t w = begin; w < end; ++w) {
+                                           for (auto word = words_[w]; word != 0;
+                                                word &= word - 1) {
+                                               *out++ = static_cast<std::uint32_t>(
+                                                   w * 64 + util::countTrailingZeros(word));
+                                           }
+                                       }
+                                   },
+                                   minWordsPerTask, maxTasks);
+        indices_ = buffer;
+    }
+    return indices_;
+}
+
+Selection operator&(Selection lhs, const Selection &rhs) { return lhs &= rhs; }
+
+Selection operator|(Selection lhs, const Selection &rhs) { return lhs |= rhs; }
+
+Selection selectRange(const Column &column, double min, double max) {
+    return selectValues(column, [min, max](double v) { return (v >= min) & (v <= max); });
+}
+
+Selection selectValid(const Column &column) {
+    return selectValues(column, [](double v) { return v == v; });
+}
+
+Selection selectEqual(const Column &column, double value) {
+    return selectValues(column, [value](double v) { return v == value; });
+}
+
+Selection selectEqual(const Column &column, const std::string &category) {
+    const auto &categorical = getCategorical(column);
+    StringDictionary::ID id;
+    if (!categorical.getDictionary().find(category.data(), category.data() + category.size(),
+                                          id)) {
+        return Selection(column.getSize());
+    }
+    return selectEqual(column, static_cast<double>(id));
+}
+
+Selection selectIn(const Column &column, std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return selectValues(column, [&values](double v) {
+        return std::binary_search(values.begin(), values.end(), v);
+    });
+}
+
+Selection selectIn(const Column &column, const std::vector<std::string> &categories) {
+    const auto &categorical = getCategorical(column);
+    const auto &dict = categorical.getDictionary();
+    // lookup table indexed by category ID
+    std::vector<std::uint8_t> selected(dict.getSize(), 0u);
+    for (const auto &category : categories) {
+        StringDictionary::ID id;
+        if (dict.find(category.data(), category.data() + category.size(), id)) {
+            selected[id] = 1u;
+        }
+    }
+    Selection selection(column.getSize());
+    const auto &ids = categorical.getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+    evaluate(ids.data(), ids.size(), [&selected](std::uint32_t id) { return selected[id] != 0; },
+             selection.getEditableWords());
+    return selection;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,175 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_SELECTION_H
+#define IVW_SELECTION_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/dataframe.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+/**
+ * \class Selection
+ * \brief Set of selected rows of a DataFrame represented as a bitmask, i.e. one bit per row.
+ * Selections of the same size can be combined with logical operations. The indices of the
+ * selected rows are provided as index buffer, which is computed on first access.
+ *
+ * \see selectRange, selectEqual, selectIn
+ */
+class IVW_MODULE_DD2257LAB1_API Selection {
+public:
+    /**
+     * @param size      number of rows
+     * @param selected  initial state of all rows
+     */
+    explicit Selection(size_t size = 0, bool selected = false);
+
+    size_t getSize() const { return size_; }
+
+    bool isSelected(size_t row) const { return ((words_[row / 64] >> (row % 64)) & 1u) != 0; }
+    void setSelected(size_t row, bool selected);
+
+    /**
+     * \brief number of selected rows
+     */
+    size_t count() const;
+
+    /**
+     * @throws Exception if the sizes of both selections do not match
+     */
+    Selection &operator&=(const Selection &rhs);
+    /// \see operator&=
+    Selection &operator|=(const Selection &rhs);
+    /**
+     * \brief selects all rows not selected and vice versa. Note that this includes rows with
+     * NaN values, \see selectValid
+     */
+    void invert();
+
+    /**
+     * \brief returns the bitmask, row i corresponds to bit i % 64 of word i / 64. Bits beyond
+     * the number of rows are always zero.
+     */
+    const std::vector<std::uint64_t> &getWords() const { return words_; }
+    /**
+     * \brief returns the bitmask for writing. Bits beyond the number of rows have to remain
+     * zero.
+     */
+    std::vector<std::uint64_t> &getEditableWords();
+
+    /**
+     * \brief returns the ascending indices of all selected rows. The buffer can be added
+     * directly to a mesh with one vertex per row for drawing only the selected rows.
+     * It is cached until the selection is modified and shared with all callers, i.e. it must
+     * not be modified.
+     */
+    std::shared_ptr<IndexBuffer> getIndexBuffer() const;
+
+private:
+    std::vector<std::uint64_t> words_;
+    size_t size_;
+    mutable std::shared_ptr<IndexBuffer> indices_;
+};
+
+IVW_MODULE_DD2257LAB1_API Selection operator&(Selection lhs, const Selection &rhs);
+IVW_MODULE_DD2257LAB1_API Selection operator|(Selection lhs, const Selection &rhs);
+
+/**
+ * Predicates are evaluated column-wise over the contiguous column values, 64 rows at a time
+ * yielding one word of the bitmask. Large columns are processed in parallel. NaN values are
+ * never selected.
+ */
+
+/**
+ * \brief selects all rows whose value lies within [min, max]
+ */
+IVW_MODULE_DD2257LAB1_API Selection selectRange(const Column &column, double min, double max);
+
+/**
+ * \brief selects all rows whose value is not NaN. Intended for restricting a selection, e.g.
+ * after Selection::invert(), which selects NaN values as well.
+ */
+IVW_MODULE_DD2257LAB1_API Selection selectValid(const Column &column);
+
+/**
+ * \brief selects all rows whose value equals \p value. For categorical columns, the value
+ * refers to the internal number representation.
+ */
+IVW_MODULE_DD2257LAB1_API Selection selectEqual(const Column &column, double value);
+
+/**
+ * \brief selects all rows of a categorical column matching the given \p category
+ *
+ * @throws InvalidConversion if the column is not categorical
+ */
+IVW_MODULE_DD2257LAB1_API Selection selectEqual(const Column &column, const std::string &category);
+
+/**
+ * \brief selects all rows whose value is contained in \p values
+ */
+IVW_MODULE_DD2257LAB1_API Selection selectIn(const Column &column, std::vector<double> values);
+
+/**
+ * \brief selects all rows of a categorical column matching any of the given \p categories
+ *
+ * @throws InvalidConversion if the column is not categorical
+ */
+IVW_MODULE_DD2257LAB1_API Selection selectIn(const Column &column,
+                                             const std::vector<std::string> &categories);
+
+using SelectionOutport = DataOutport<Selection>;
+using SelectionInport = DataInport<Selection>;
+
+template <>
+struct port_traits<Selection> {
+    static std::string class_identifier() { return "Selection"; }
+    static uvec3 color_code() { return uvec3(204, 102, 0); }
+    static std::string data_info(const Selection *data) {
+        using H = utildoc::TableBuilder::Header;
+        using P = Document::PathComponent;
+        Document doc;
+        doc.append("b", "Selection", {{"style", "color:white;"}});
+        utildoc::TableBuilder tb(doc.handle(), P::end());
+        tb(H("Rows: "), data->getSize());
+        tb(H("Selected: "), data->count());
+        return doc;
+    }
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_SELECTION_H
@@ -0,0 +1,168 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/sortedindex.h>
+#include <dd2257lab1/utils/instrumentation.h>
+#include <dd2257lab1/utils/parallel.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace inviwo {
+
+namespace {
+
+// rows per task when fetching values and testing ranks
+constexpr size_t minRowsPerTask = size_t{1} << 16;
+
+std::vector<double> getAllValues(const Column &column) {
+    if (column.getSize() >= SortedColumnIndex::noRank) {
+        throw Exception("SortedColumnIndex: column \"" + column.getHeader() +
+                        "\" has too many rows (" + std::to_string(column.getSize()) + ")");
+    }
+    std::vector<double> values(column.getSize());
+    column.getValuesAsDouble(0, values.size(), values.data());
+    return values;
+}
+
+}  // namespace
+
+constexpr std::uint32_t SortedColumnIndex::noRank;
+
+SortedColumnIndex::SortedColumnIndex(const Column &column)
+    : SortedColumnIndex(getAllValues(column)) {}
+
+SortedColumnIndex::SortedColumnIndex(std::vector<double> values) {
+    DD2257_SCOPED_TIMER("SortedColumnIndex::build");
+    const size_t size = values.size();
+    if (size >= noRank) {
+        throw Exception("SortedColumnIndex: too many rows (" + std::to_string(size) + ")");
+    }
+
+    // sort (value, row) pairs rather than a permutation, comparisons then stay in cache
+    std::vector<std::pair<double, std::uint32_t>> entries;
+    entries.reserve(size);
+    for (size_t row = 0; row < size; ++row) {
+        if (!std::isnan(values[row])) {
+            entries.emplace_back(values[row], static_cast<std::uint32_t>(row));
+        }
+    }
+    values.clear();
+    values.shrink_to_fit();
+
+    util::parallelStableSort(entries.begin(), entries.end(),
+                             [](const std::pair<double, std::uint32_t> &a,
+                                const std::pair<double, std::uint32_t> &b) {
+                                 return a.first < b.first;
+                             });
+
+    values_.resize(entries.size());
+    rows_.resize(entries.size());
+    ranks_.assign(size, noRank);
+    util::forEachRangeParallel(entries.size(),
+                               [&](size_t begin, size_t end, size_t) {
+                                   for (size_t i = begin; i < end; ++i) {
+                                       values_[i] = entries[i].first;
+                                       rows_[i] = entries[i].second;
+                                       ranks_[entries[i].second] = static_cast<std::uint32_t>(i);
+                                   }
+                               },
+                               minRowsPerTask);
+    DD2257_GAUGE("SortedColumnIndex::bytes",
+                 size * sizeof(std::uint32_t) +
+                     entries.size() * (sizeof(double) + sizeof(std::uint32_t)));
+}
+
+std::pair<size_t, size_t> SortedColumnIndex::findRange(double min, double max) const {
+    const auto first = std::lower_bound(values_.begin(), values_.end(), min);
+    const auto last = std::upper_bound(first, values_.end(), max);
+    return {static_cast<size_t>(first - values_.begin()),
+            static_cast<size_t>(std::max(first, last) - values_.begin())};
+}
+
+std::vector<std::uint32_t> findRowsInRanges(const std::vector<const SortedColumnIndex *> &indices,
+                                            const std::vector<dvec2> &ranges) {
+    DD2257_SCOPED_TIMER("findRowsInRanges");
+    if (indices.size() != ranges.size()) {
+        throw Exception("findRowsInRanges: got " + std::to_string(indices.size()) +
+                        " indices but " + std::to_string(ranges.size()) + " ranges");
+    }
+    if (indices.empty()) return {};
+    for (auto index : indices) {
+        if (index->getNumberOfRows() != indices.front()->getNumberOfRows()) {
+            throw Exception("findRowsInRanges: number of rows do not match");
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> found;
+    size_t narrowest = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        found.push_back(indices[i]->findRange(ranges[i].x, ranges[i].y));
+        const auto width = found[i].second - found[i].first;
+        if (width < found[narrowest].second - found[narrowest].first) {
+            narrowest = i;
+        }
+    }
+
+    // test the rows of the narrowest range against all other ranges by rank
+    const auto &candidates = indices[narrowest]->getRows();
+    const size_t first = found[narrowest].first;
+    const size_t count = found[narrowest].second - first;
+    std::vector<std::vector<std::uint32_t>> taskRows(util::getHardwareThreadCount());
+    const size_t tasks = util::forEachRangeParallel(
+        count,
+        [&](size_t begin, size_t end, size_t task) {
+            auto &rows = taskRows[task];
+            for (size_t k = first + begin; k < first + end; ++k) {
+                const auto row = candidates[k];
+                bool inside = true;
+                for (size_t i = 0; i < indices.size() && inside; ++i) {
+                    const auto rank = indices[i]->getRank(row);
+                    inside = i == narrowest ||
+                             (rank >= found[i].first && rank < found[i].second);
+                }
+                if (inside) rows.push_back(row);
+            }
+            std::sort(rows.begin(), rows.end());
+        },
+        minRowsPerTask, taskRows.size());
+
+    // merge the sorted rows of all tasks
+    std::vector<std::uint32_t> result;
+    for (size_t task = 0; task < tasks; ++task) {
+        const auto mid = result.size();
+        result.insert(result.end(), taskRows[task].begin(), taskRows[task].end());
+        std::inplace_merge(result.begin(), result.begin() + mid, result.end());
+    }
+    DD2257_COUNTER("findRowsInRanges::candidates", count);
+    return result;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,106 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_SORTEDINDEX_H
+#define IVW_SORTEDINDEX_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <dd2257lab1/utils/column.h>
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief rows of a column sorted by value, for resolving value ranges by binary search.
+ *
+ * Building the index sorts all values once, afterwards findRange() is O(log n) and the rows
+ * within a range are a contiguous part of getRows(). The rank of each row, i.e. its position
+ * in the sorted order, allows testing in O(1) whether a row lies within a range found before.
+ * Rows with NaN values are not part of the index.
+ */
+class IVW_MODULE_DD2257LAB1_API SortedColumnIndex {
+public:
+    /// marks rows without a rank, i.e. rows with NaN values
+    static constexpr std::uint32_t noRank = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * \brief sorts the values of \p column in parallel
+     * @throws Exception if the column has more rows than can be indexed by 32 bit
+     */
+    explicit SortedColumnIndex(const Column &column);
+    /**
+     * \brief sorts \p values in parallel, e.g. values gathered from a subset of rows
+     * @throws Exception if there are more values than can be indexed by 32 bit
+     */
+    explicit SortedColumnIndex(std::vector<double> values);
+
+    /// number of indexed rows, i.e. rows without NaN
+    size_t size() const { return rows_.size(); }
+    /// number of rows of the column
+    size_t getNumberOfRows() const { return ranks_.size(); }
+
+    /// values in ascending order
+    const std::vector<double> &getValues() const { return values_; }
+    /// rows in the order of getValues()
+    const std::vector<std::uint32_t> &getRows() const { return rows_; }
+    /// position of \p row in getRows() or noRank
+    std::uint32_t getRank(size_t row) const { return ranks_[row]; }
+
+    /**
+     * \brief returns the range [first, second) of positions in getRows() whose values lie
+     * within [\p min, \p max]
+     */
+    std::pair<size_t, size_t> findRange(double min, double max) const;
+
+private:
+    std::vector<double> values_;
+    std::vector<std::uint32_t> rows_;
+    std::vector<std::uint32_t> ranks_;
+};
+
+/**
+ * \brief returns the ascending rows whose value lies within ranges[i] for every index i, e.g.
+ * the rows within the brushes of several axes. Only the rows within the narrowest range are
+ * visited, the others are tested by rank. Runs in parallel for large ranges.
+ *
+ * @throws Exception if the sizes of \p indices and \p ranges or the number of rows of the
+ * indices do not match
+ */
+IVW_MODULE_DD2257LAB1_API std::vector<std::uint32_t> findRowsInRanges(
+    const std::vector<const SortedColumnIndex *> &indices, const std::vector<dvec2> &ranges);
+
+}  // namespace inviwo
+
+#endif  // IVW_SORTEDINDEX_H
@@ -0,0 +1,136 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <dd2257lab1/utils/stringdictionary.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace inviwo {
+
+StringDictionary::ID StringDictionary::addOrGetID(const char *first, const char *last) {
+    // keep the load factor below 1/2
+    if (2 * (getSize() + 1) > slots_.size()) {
+        rehash(std::max<size_t>(16u, 2 * slots_.size()));
+    }
+    const auto h = hash(first, last);
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = static_cast<size_t>(h) & mask;; slot = (slot + 1) & mask) {
+        if (slots_[slot] == 0) {
+            const auto id = static_cast<ID>(getSize());
+            chars_.insert(chars_.end(), first, last);
+            offsets_.push_back(chars_.size());
+            hashes_.push_back(h);
+            slots_[slot] = id + 1;
+            return id;
+        } else if (equals(slots_[slot] - 1, h, first, last)) {
+            return slots_[slot] - 1;
+        }
+    }
+}
+
+StringDictionary::ID StringDictionary::addOrGetID(const std::string &str) {
+    return addOrGetID(str.data(), str.data() + str.size());
+}
+
+bool StringDictionary::find(const char *first, const char *last, ID &id) const {
+    if (slots_.empty()) return false;
+    const auto h = hash(first, last);
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = static_cast<size_t>(h) & mask; slots_[slot] != 0;
+         slot = (slot + 1) & mask) {
+        if (equals(slots_[slot] - 1, h, first, last)) {
+            id = slots_[slot] - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string StringDictionary::get(ID id) const { return std::string(data(id), length(id)); }
+
+size_t StringDictionary::getMemoryUsage() const {
+    return chars_.capacity() * sizeof(char) + offsets_.capacity() * sizeof(std::uint64_t) +
+           hashes_.capacity() * sizeof(std::uint64_t) + slots_.capacity() * sizeof(ID);
+}
+
+void StringDictionary::clear() {
+    chars_.clear();
+    offsets_.assign(1, 0u);
+    hashes_.clear();
+    slots_.clear();
+}
+
+void StringDictionary::assign(const char *chars, const std::uint64_t *offsets, size_t count) {
+    const auto base = offsets[0];
+    chars_.assign(chars + base, chars + offsets[count]);
+    offsets_.resize(count + 1);
+    hashes_.resize(count);
+    for (size_t i = 0; i <= count; ++i) {
+        offsets_[i] = offsets[i] - base;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        hashes_[i] = hash(chars + offsets[i], chars + offsets[i + 1]);
+    }
+    size_t slotCount = 16;
+    while (slotCount < 2 * (count + 1)) slotCount *= 2;
+    rehash(slotCount);
+}
+
+std::uint64_t StringDictionary::hash(const char *first, const char *last) {
+    // FNV-1a
+    std::uint64_t h = 14695981039346656037ull;
+    for (; first != last; ++first) {
+        h ^= static_cast<unsigned char>(*first);
+        h *= 1099511628211ull;
+    }
+    // mix the upper bits into the lower ones, which are used for addressing the table
+    return h ^ (h >> 32);
+}
+
+bool StringDictionary::equals(ID id, std::uint64_t hash, const char *first,
+                              const char *last) const {
+    const size_t len = static_cast<size_t>(last - first);
+    return (hashes_[id] == hash) && (length(id) == len) &&
+           ((len == 0) || (std::memcmp(data(id), first, len) == 0));
+}
+
+void StringDictionary::rehash(size_t slotCount) {
+    slots_.assign(slotCount, 0u);
+    const size_t mask = slotCount - 1;
+    for (size_t id = 0; id < hashes_.size(); ++id) {
+        size_t slot = static_cast<size_t>(hashes_[id]) & mask;
+        while (slots_[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = static_cast<ID>(id + 1);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,114 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2017 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_STRINGDICTIONARY_H
+#define IVW_STRINGDICTIONARY_H
+
+#include <dd2257lab1/dd2257lab1moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class StringDictionary
+ * \brief Maps distinct strings onto consecutive IDs 0, 1, 2, ... in the order of insertion.
+ *
+ * All strings are stored back to back in a single character arena. Lookups use an open
+ * addressing hash table holding IDs only, i.e. strings are neither allocated nor copied
+ * for looking up a value. Since the table refers to strings by offset, copying a dictionary
+ * copies a handful of vectors.
+ */
+class IVW_MODULE_DD2257LAB1_API StringDictionary {
+public:
+    using ID = std::uint32_t;
+
+    StringDictionary() = default;
+
+    /**
+     * \brief returns the ID of the string [first, last), the string is added if necessary
+     */
+    ID addOrGetID(const char *first, const char *last);
+    ID addOrGetID(const std::string &str);
+
+    /**
+     * \brief looks up the ID of the string [first, last)
+     * @return false if the string is not part of the dictionary
+     */
+    bool find(const char *first, const char *last, ID &id) const;
+
+    std::string get(ID id) const;
+    const char *data(ID id) const { return chars_.data() + offsets_[id]; }
+    size_t length(ID id) const { return static_cast<size_t>(offsets_[id + 1] - offsets_[id]); }
+
+    /**
+     * \brief number of distinct strings, i.e. the cardinality of the dictionary
+     */
+    size_t getSize() const { return offsets_.size() - 1; }
+    /**
+     * \brief number of bytes used for storing the characters of all strings
+     */
+    size_t getStringBytes() const { return chars_.size(); }
+    /**
+     * \brief total number of bytes allocated by the dictionary including the hash table
+     */
+    size_t getMemoryUsage() const;
+
+    void clear();
+
+    /**
+     * \brief replaces the content of the dictionary with \p count strings given as one block of
+     * characters and count + 1 offsets into this block, i.e. string i is
+     * [chars + offsets[i], chars + offsets[i + 1]). The strings have to be distinct, offsets
+     * must be ascending, and offsets[count] must not exceed the size of the block.
+     */
+    void assign(const char *chars, const std::uint64_t *offsets, size_t count);
+
+    /// all strings back to back, \see getOffsets()
+    const std::vector<char> &getCharacters() const { return chars_; }
+    /// start of each string in getCharacters() followed by the total number of characters
+    const std::vector<std::uint64_t> &getOffsets() const { return offsets_; }
+
+private:
+    static std::uint64_t hash(const char *first, const char *last);
+    bool equals(ID id, std::uint64_t hash, const char *first, const char *last) const;
+    void rehash(size_t slotCount);
+
+    std::vector<char> chars_;
+    std::vector<std::uint64_t> offsets_{0};  // string i occupies [offsets_[i], offsets_[i + 1])
+    std::vector<std::uint64_t> hashes_;
+    std::vector<ID> slots_;  // ID + 1 of the string in this slot, 0 marks an empty slot
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_STRINGDICTIONARY_H
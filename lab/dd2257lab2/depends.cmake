@@ -2,6 +2,7 @@
 # Dependencies for current module
 # List modules in the format "Inviwo<ModuleName>Module"
 set(dependencies
+    InviwoDD2257Lab1Module
     #InviwoOpenGLModule
     #InviwoBaseGLModule  
 )
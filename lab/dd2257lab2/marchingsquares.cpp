@@ -11,6 +11,7 @@
 #include <dd2257lab2/marchingsquares.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
 #include <inviwo/core/util/utilities.h>
+#include <dd2257lab1/utils/instrumentation.h>
 
 namespace inviwo
 {
@@ -163,6 +164,8 @@ double MarchingSquares::getInputValue(const VolumeRAM* data, size3_t dims, size_
 
 void MarchingSquares::process()
 {
+    DD2257_SCOPED_TIMER("MarchingSquares::process");
+    ambiguousCells_ = 0;
 	propIsoTransferFunc.get().clearPoints();
     propIsoTransferFunc.get().addPoint(vec2(0.0f, 1.0f), propIsoColorMin.get());
     propIsoTransferFunc.get().addPoint(vec2(1.0f, 1.0f), propIsoColorMax.get());
@@ -399,6 +402,9 @@ void MarchingSquares::process()
     // Also, consider to write helper functions to avoid code duplication
     // e.g. for the computation of a single iso contour
 
+    DD2257_COUNTER("MarchingSquares::vertices", vertices.size());
+    DD2257_COUNTER("MarchingSquares::ambiguousCells", ambiguousCells_);
+    DD2257_GAUGE("MarchingSquares::meshBytes", vertices.size() * sizeof(BasicMesh::Vertex));
 	meshGrid->addVertices(vertices);
 	meshOut.setData(meshGrid);
 }
@@ -477,7 +483,7 @@ std::vector<vec3> MarchingSquares::getIsoVertices(int xIdx, int yIdx, float val0
 	//negative case (-)
     else if ((val00 >= isoValue && val11 >= isoValue && val01 < isoValue && val10 < isoValue && midPoint < isoValue && propDeciderType.get() == 0) ||
     	(val00 < isoValue && val11 < isoValue && val01 >= isoValue && val10 >= isoValue && midPoint >= isoValue && propDeciderType.get() == 0)) {
-    	LogProcessorInfo("mid point:" << midPoint);
+    	++ambiguousCells_;
     	vIso.push_back(isoPosBotton);
     	vIso.push_back(isoPosLeft);
         vIso.push_back(isoPosUp);
@@ -486,7 +492,7 @@ std::vector<vec3> MarchingSquares::getIsoVertices(int xIdx, int yIdx, float val0
 	//positive case (+)
     else if ((val00 >= isoValue && val11 >= isoValue && val01 < isoValue && val10 < isoValue && midPoint >= isoValue && propDeciderType.get() == 0) ||
     	(val00 < isoValue && val11 < isoValue && val01 >= isoValue && val10 >= isoValue && midPoint < isoValue && propDeciderType.get() == 0)) {
-    	LogProcessorInfo("mid point:" << midPoint);
+    	++ambiguousCells_;
     	vIso.push_back(isoPosBotton);
     	vIso.push_back(isoPosRight);
         vIso.push_back(isoPosUp);
@@ -496,7 +502,7 @@ std::vector<vec3> MarchingSquares::getIsoVertices(int xIdx, int yIdx, float val0
 	// else if c > f(x_a,y_a) connect (a,b) and (c,d)
     else if ((val00 >= isoValue && val11 >= isoValue && val01 < isoValue && val10 < isoValue && asymPoint < isoValue && propDeciderType.get() == 1) ||
     	(val00 < isoValue && val11 < isoValue && val01 >= isoValue && val10 >= isoValue && asymPoint >= isoValue && propDeciderType.get() == 1)) {
-    	LogProcessorInfo("asymptotic point:" <<asymPoint);
+    	++ambiguousCells_;
     	vIso.push_back(isoPosBotton);
     	vIso.push_back(isoPosLeft);
         vIso.push_back(isoPosUp);
@@ -504,7 +510,7 @@ std::vector<vec3> MarchingSquares::getIsoVertices(int xIdx, int yIdx, float val0
     }
     else if ((val00 >= isoValue && val11 >= isoValue && val01 < isoValue && val10 < isoValue && asymPoint >= isoValue && propDeciderType.get() == 1) ||
     	(val00 < isoValue && val11 < isoValue && val01 >= isoValue && val10 >= isoValue && asymPoint < isoValue && propDeciderType.get() == 1)) {
-    	LogProcessorInfo("Asymptotic point:" << asymPoint);
+    	++ambiguousCells_;
     	vIso.push_back(isoPosBotton);
     	vIso.push_back(isoPosRight);
         vIso.push_back(isoPosUp);
@@ -107,7 +107,8 @@ public:
 
 //Attributes
 private:
-
+    // ambiguous cells resolved by a decider during the current process(), reported once
+    size_t ambiguousCells_ = 0;
 };
 
 } // namespace
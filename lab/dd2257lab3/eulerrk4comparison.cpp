@@ -12,6 +12,7 @@
 #include <dd2257lab3/integrator.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
 #include <inviwo/core/interaction/events/mouseevent.h>
+#include <dd2257lab1/utils/instrumentation.h>
 
 namespace inviwo
 {
@@ -91,7 +92,6 @@ void EulerRK4Comparison::drawPoint(vec3& pt, vec4& xColor,std::vector<BasicMesh:
 	// add first point
 	auto plt_pt = vec3(pt.x / (dims.x - 1), pt.y / (dims.y - 1), 0);
 	pt = origin + plt_pt * axisScaler;
-	LogProcessorInfo("@" + std::to_string(pointCounter) + " [ " + std::to_string(pt[0]) + " , " + std::to_string(pt[1]) + " ] ");
 
 	vertices.push_back({ pt, vec3(0), vec3(0), xColor });
 	bufferPoint->add(static_cast<std::uint32_t>(pointCounter));
@@ -114,6 +114,7 @@ void EulerRK4Comparison::eventMoveStart(Event* event)
 
 void EulerRK4Comparison::process()
 {
+    DD2257_SCOPED_TIMER("EulerRK4Comparison::process");
     // Get input
     if (!inData.hasData())
     {
@@ -140,17 +141,6 @@ void EulerRK4Comparison::process()
     // Draw start point
     vec2 startPoint = propStartPoint.get();
 
-	// data print
-	LogProcessorInfo(" --- Data::begin ---");
-	for (int i = 0; i < dims.x; i++) {
-		for (int j = 0; j < dims.y; j++) {
-			auto v = getInputValue(vr, dims, i, j);
-			LogProcessorInfo(" [ "+std::to_string(i)+" , " + std::to_string(j)+" ] = "+ std::to_string(v));
-		}
-	}
-	LogProcessorInfo(" --- Data::end ---");
-	LogProcessorInfo(" ");
-
     // TODO: Implement the Euler and Runge-Kutta of 4th order integration schemes
     // and then integrate forward for a specified number of integration steps and a given stepsize 
     // (these should be additional properties of the processor)
@@ -161,32 +151,30 @@ void EulerRK4Comparison::process()
 	auto plt_pt = vec3(pt, 0);
 	drawPoint(plt_pt, propEulerColor.get(), vertices, pointCounter, indexBufferEuler, indexBufferPointsEuler);
 
-	LogProcessorInfo(" --- Euler::begin ---");
-	for (int i = 0; i < propIntegrationStepsCount.get(); i++) {
-		pt = integrator.Euler(vr, dims, pt, propIntegrationStepsMagnitude.get());
-		plt_pt = vec3(pt, 0); 
-		LogProcessorInfo("@" + std::to_string(i) +" [ " + std::to_string(plt_pt[0]) + " , " + std::to_string(plt_pt[1]) + " ] ");
-		drawPoint(plt_pt, propEulerColor.get(), vertices, pointCounter, indexBufferEuler, indexBufferPointsEuler);
+	{
+		DD2257_SCOPED_TIMER("EulerRK4Comparison::Euler");
+		for (int i = 0; i < propIntegrationStepsCount.get(); i++) {
+			pt = integrator.Euler(vr, dims, pt, propIntegrationStepsMagnitude.get());
+			plt_pt = vec3(pt, 0); 
+			drawPoint(plt_pt, propEulerColor.get(), vertices, pointCounter, indexBufferEuler, indexBufferPointsEuler);
+		}
 	}
-	LogProcessorInfo(" --- Euler::end ---");
-	LogProcessorInfo(" ");
 
     // Integrator::Rk4(vr, dims, startPoint, ...);
 	pt = startPoint;
 	plt_pt = vec3(pt, 0);
 	drawPoint(plt_pt, propRK4Color.get(), vertices, pointCounter, indexBufferRK, indexBufferPointsRK);
 
-	LogProcessorInfo(" --- RK4::begin ---");
-	for (int i = 0; i < propIntegrationStepsCount.get(); i++) {
-		pt = integrator.RK4(vr, dims, pt, propIntegrationStepsMagnitude.get());
-		plt_pt = vec3(pt, 0); 
-		LogProcessorInfo("@" + std::to_string(i) + " [ " + std::to_string(plt_pt[0]) + " , " + std::to_string(plt_pt[1]) + " ] ");
-		drawPoint(plt_pt, propRK4Color.get(), vertices, pointCounter, indexBufferRK, indexBufferPointsRK);
-
+	{
+		DD2257_SCOPED_TIMER("EulerRK4Comparison::RK4");
+		for (int i = 0; i < propIntegrationStepsCount.get(); i++) {
+			pt = integrator.RK4(vr, dims, pt, propIntegrationStepsMagnitude.get());
+			plt_pt = vec3(pt, 0); 
+			drawPoint(plt_pt, propRK4Color.get(), vertices, pointCounter, indexBufferRK, indexBufferPointsRK);
+		}
 	}
-	LogProcessorInfo(" --- RK4::end ---");
-	LogProcessorInfo(" ");
 
+    DD2257_COUNTER("EulerRK4Comparison::vertices", vertices.size());
 	mesh->addVertices(vertices);
 	outMesh.setData(mesh);
 }
@@ -12,6 +12,7 @@
 #include <dd2257lab3/integrator.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/interaction/events/mouseevent.h>
+#include <dd2257lab1/utils/instrumentation.h>
 
 namespace inviwo
 {
@@ -148,7 +149,6 @@ void StreamlineIntegrator::drawPoint(vec3& pt, vec4& xColor, std::vector<BasicMe
 	// add first point
 	auto plt_pt = vec3(pt.x / (dims.x - 1), pt.y / (dims.y - 1), 0);
 	pt = origin + plt_pt * axisScaler;
-	LogProcessorInfo("@" + std::to_string(pointCounter) + " [ " + std::to_string(pt[0]) + " , " + std::to_string(pt[1]) + " ] ");
 
 	vertices.push_back({ pt, vec3(0), vec3(0), xColor });
 	bufferPoint->add(static_cast<std::uint32_t>(pointCounter));
@@ -159,6 +159,7 @@ void StreamlineIntegrator::drawPoint(vec3& pt, vec4& xColor, std::vector<BasicMe
 
 void StreamlineIntegrator::process()
 {
+    DD2257_SCOPED_TIMER("StreamlineIntegrator::process");
     // Get input
 	if (!inData.hasData()) {
 		return;
@@ -223,7 +224,6 @@ void StreamlineIntegrator::process()
 
 		for (auto pt : list) {
 			auto plt_pt = vec3(pt, 0);
-			LogProcessorInfo(std::to_string(plt_pt[0]) +" , " + std::to_string(plt_pt[1]));
 			drawPoint(plt_pt, propSingleColor.get(), vertices, pointCounter, indexBufferLines, indexBufferPoints);
 		}
 
@@ -235,6 +235,7 @@ void StreamlineIntegrator::process()
         // (TODO: Bonus, sample randomly according to magnitude of the vector field)
     }
 
+    DD2257_COUNTER("StreamlineIntegrator::vertices", vertices.size());
 	mesh->addVertices(vertices);
 	outMesh.setData(mesh);
 }
@@ -15,7 +15,7 @@
 #include <math.h>
 #include <iostream>
 #include <fstream>
-#include <ctime>
+#include <dd2257lab1/utils/instrumentation.h>
 
 namespace inviwo
 {
@@ -197,7 +197,8 @@ std::vector<std::vector<vec4>> LICProcessor::FastLIC(const inviwo::ImageRAM * tr
 		}
 	}
 
-	LogProcessorInfo("Saved points : " + std::to_string(savedPoints) + " .");
+	DD2257_COUNTER("LICProcessor::FastLIC::savedPoints", savedPoints);
+	(void)savedPoints;  // only read by the instrumentation
 	return matrix;
 }
 
@@ -346,6 +347,7 @@ LICProcessor::LICProcessor()
 
 void LICProcessor::process()
 {
+    DD2257_SCOPED_TIMER("LICProcessor::process");
     // Get input
 	if (!volumeIn_.hasData()) {
 		return;
@@ -377,17 +379,23 @@ void LICProcessor::process()
     
 	std::vector<std::vector<vec4> > licTexture;
 
-	clock_t begin = clock();
 	if (propUseFastLIC.get())
+	{
+		DD2257_SCOPED_TIMER("LICProcessor::FastLIC");
 		licTexture = FastLIC(tr, texDims_, vr, vectorFieldDims_);
+	}
 	else
+	{
+		DD2257_SCOPED_TIMER("LICProcessor::LIC");
 		licTexture = LIC(tr, texDims_, vr, vectorFieldDims_);
-	clock_t end = clock();
-	double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC;
-	LogProcessorInfo("Elapsed seconds for computation: "+ std::to_string(elapsed_secs)+" .");
+	}
+	DD2257_COUNTER("LICProcessor::pixels", texDims_.x * texDims_.y);
 	//double val11 = licTexture[1][1][0], val3030= licTexture[30][30][0];
 	if (propApplyContrastEnh.get())
+	{
+		DD2257_SCOPED_TIMER("LICProcessor::contrastEnhancement");
 		applyContrastEnhancement(licTexture, texDims_, propContrastMean.get(), propContrastStd.get());
+	}
 
 	//double val11_ = licTexture[1][1][0], val3030_ = licTexture[30][30][0];
 